@@ -0,0 +1,287 @@
+#ifndef AUGMENTING_PATHS_HPP
+#define AUGMENTING_PATHS_HPP
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "flow_graph.hpp"
+
+// Augmenting-path max flow solvers on a FlowGraph. Like PushRelabel, each one
+// works on a caller-owned residual array (indexed by arc, initialised to the
+// capacities) and counts its work: augmentations is the number of paths
+// pushed, arcScans the number of arcs examined while searching for them.
+
+// Ford-Fulkerson with a depth-first path search. The path is kept on an
+// explicit arc stack, so relay chains of any depth fit, and every node keeps
+// a current-arc pointer. Within a round the pointers and the dead-end marks
+// survive each augmentation: the search resumes from the tail of the first
+// saturated arc instead of restarting at the source. Stale marks can only
+// hide paths, never invent them, so a round that finds nothing from fresh
+// marks proves the flow maximal.
+class FordFulkerson {
+private:
+    enum : char { UNVISITED, ON_PATH, DEAD };
+
+    const FlowGraph &graph;
+    std::vector<int> &residual;
+    std::vector<int> currentArc, path;
+    std::vector<char> state;
+
+    long long augmentingRound(NodeId source, NodeId sink) {
+        currentArc.assign(graph.offset.begin(), graph.offset.end() - 1);
+        state.assign(graph.numNodes, UNVISITED);
+        path.clear();
+        long long totalFlow = 0;
+        NodeId node = source;
+        state[source] = ON_PATH;
+
+        while (true) {
+            if (node == sink) {
+                int flow = std::numeric_limits<int>::max();
+                for (int a : path) flow = std::min(flow, residual[a]);
+
+                size_t retreatTo = path.size();
+                for (size_t i = 0; i < path.size(); i++) {
+                    int a = path[i];
+                    residual[a] -= flow;
+                    residual[graph.reverse[a]] += flow;
+                    if (residual[a] == 0 && retreatTo == path.size()) retreatTo = i;
+                }
+                totalFlow += flow;
+                augmentations++;
+
+                // Nodes past the saturated arc leave the path and may be reached again
+                for (size_t i = retreatTo; i < path.size(); i++) state[graph.head[path[i]]] = UNVISITED;
+                node = graph.tail(path[retreatTo]);
+                path.resize(retreatTo);
+                continue;
+            }
+
+            int end = graph.offset[node + 1];
+            int &a = currentArc[node];
+            int first = a;
+            while (a < end && !(residual[a] > 0 && state[graph.head[a]] == UNVISITED)) a++;
+            arcScans += a - first + (a < end);
+
+            if (a < end) {
+                path.push_back(a);
+                node = graph.head[a];
+                state[node] = ON_PATH;
+            } else {
+                state[node] = DEAD;
+                if (node == source) break;
+                int back = path.back();
+                path.pop_back();
+                node = graph.tail(back);
+                currentArc[node]++;
+            }
+        }
+        return totalFlow;
+    }
+
+public:
+    long long augmentations = 0, arcScans = 0;
+
+    FordFulkerson(const FlowGraph &g, std::vector<int> &residualCapacity) : graph(g), residual(residualCapacity) {}
+
+    long long maxFlow(NodeId source, NodeId sink) {
+        augmentations = arcScans = 0;
+        if (source == sink) return 0;
+        long long total = 0;
+        while (long long flow = augmentingRound(source, sink)) total += flow;
+        return total;
+    }
+};
+
+// Edmonds-Karp: shortest augmenting paths by BFS. With delta > 1 only arcs
+// with at least delta residual capacity are used, which is one phase of
+// capacity scaling.
+class EdmondsKarp {
+private:
+    const FlowGraph &graph;
+    std::vector<int> &residual;
+    std::vector<int> parentArc;
+    std::queue<NodeId> q;
+
+    bool bfs(NodeId source, NodeId sink, int delta) {
+        parentArc.assign(graph.numNodes, -1);
+        q = std::queue<NodeId>();
+        q.push(source);
+
+        while (!q.empty()) {
+            NodeId node = q.front();
+            q.pop();
+            for (int a = graph.offset[node]; a < graph.offset[node + 1]; a++) {
+                arcScans++;
+                NodeId next = graph.head[a];
+                if (next != source && parentArc[next] == -1 && residual[a] >= delta) {
+                    parentArc[next] = a;
+                    if (next == sink) return true;
+                    q.push(next);
+                }
+            }
+        }
+        return false;
+    }
+
+    int augment(NodeId source, NodeId sink) {
+        int pathFlow = std::numeric_limits<int>::max();
+        for (NodeId v = sink; v != source; v = graph.tail(parentArc[v])) pathFlow = std::min(pathFlow, residual[parentArc[v]]);
+        for (NodeId v = sink; v != source; v = graph.tail(parentArc[v])) {
+            int a = parentArc[v];
+            residual[a] -= pathFlow;
+            residual[graph.reverse[a]] += pathFlow;
+        }
+        augmentations++;
+        return pathFlow;
+    }
+
+public:
+    long long augmentations = 0, arcScans = 0;
+
+    EdmondsKarp(const FlowGraph &g, std::vector<int> &residualCapacity) : graph(g), residual(residualCapacity) {}
+
+    // Augments until no path with residual >= delta is left
+    long long maxFlow(NodeId source, NodeId sink, int delta = 1) {
+        augmentations = arcScans = 0;
+        if (source == sink) return 0;
+        long long total = 0;
+        while (bfs(source, sink, delta)) total += augment(source, sink);
+        return total;
+    }
+};
+
+// Capacity scaling: Edmonds-Karp phases on the delta-residual graph for
+// delta = 2^k, ..., 1. Every path in phase delta carries at least delta
+// units, so each phase needs at most 2m augmentations: O(m^2 log U) overall.
+class CapacityScaling {
+private:
+    const FlowGraph &graph;
+    std::vector<int> &residual;
+
+public:
+    long long augmentations = 0, arcScans = 0;
+    std::vector<std::pair<int, long long>> phaseAugmentations; // (delta, augmentations) per phase
+
+    CapacityScaling(const FlowGraph &g, std::vector<int> &residualCapacity) : graph(g), residual(residualCapacity) {}
+
+    long long maxFlow(NodeId source, NodeId sink) {
+        augmentations = arcScans = 0;
+        phaseAugmentations.clear();
+        int maxCapacity = graph.maxCapacity();
+        if (maxCapacity == 0 || source == sink) return 0;
+
+        int delta = 1;
+        while (delta <= maxCapacity / 2) delta *= 2;
+
+        EdmondsKarp phase(graph, residual);
+        long long total = 0;
+        for (; delta > 0; delta /= 2) {
+            total += phase.maxFlow(source, sink, delta);
+            phaseAugmentations.push_back({delta, phase.augmentations});
+            augmentations += phase.augmentations;
+            arcScans += phase.arcScans;
+        }
+        return total;
+    }
+};
+
+// Dinic: blocking flows on BFS level graphs. The path is kept on an explicit
+// arc stack and currentArc[u] only moves forward, so each arc is either
+// advanced over or discarded once per phase.
+class Dinic {
+private:
+    const FlowGraph &graph;
+    std::vector<int> &residual;
+    std::vector<int> level, currentArc, path;
+    std::queue<NodeId> q;
+
+    // Label nodes by BFS distance from source over arcs with residual capacity
+    bool buildLevelGraph(NodeId source, NodeId sink) {
+        level.assign(graph.numNodes, -1);
+        level[source] = 0;
+        q.push(source);
+
+        while (!q.empty()) {
+            NodeId node = q.front();
+            q.pop();
+            for (int a = graph.offset[node]; a < graph.offset[node + 1]; a++) {
+                arcScans++;
+                NodeId next = graph.head[a];
+                if (level[next] == -1 && residual[a] > 0) {
+                    level[next] = level[node] + 1;
+                    q.push(next);
+                }
+            }
+        }
+        return level[sink] != -1;
+    }
+
+    long long blockingFlow(NodeId source, NodeId sink) {
+        currentArc.assign(graph.offset.begin(), graph.offset.end() - 1);
+        path.clear();
+        long long totalFlow = 0;
+        NodeId node = source;
+
+        while (true) {
+            if (node == sink) {
+                int flow = std::numeric_limits<int>::max();
+                for (int a : path) flow = std::min(flow, residual[a]);
+
+                size_t retreatTo = path.size();
+                for (size_t i = 0; i < path.size(); i++) {
+                    int a = path[i];
+                    residual[a] -= flow;
+                    residual[graph.reverse[a]] += flow;
+                    if (residual[a] == 0 && retreatTo == path.size()) retreatTo = i;
+                }
+                totalFlow += flow;
+                augmentations++;
+
+                // Resume from the tail of the first saturated arc
+                node = graph.tail(path[retreatTo]);
+                path.resize(retreatTo);
+                continue;
+            }
+
+            int end = graph.offset[node + 1];
+            int &a = currentArc[node];
+            int first = a;
+            while (a < end && !(residual[a] > 0 && level[graph.head[a]] == level[node] + 1)) a++;
+            arcScans += a - first + (a < end);
+
+            if (a < end) {
+                path.push_back(a);
+                node = graph.head[a];
+            } else {
+                if (node == source) break;
+                level[node] = -1; // Dead end, drop it from the level graph
+                int back = path.back();
+                path.pop_back();
+                node = graph.tail(back);
+                currentArc[node]++;
+            }
+        }
+        return totalFlow;
+    }
+
+public:
+    long long augmentations = 0, arcScans = 0, phases = 0;
+
+    Dinic(const FlowGraph &g, std::vector<int> &residualCapacity) : graph(g), residual(residualCapacity) {}
+
+    long long maxFlow(NodeId source, NodeId sink) {
+        augmentations = arcScans = phases = 0;
+        if (source == sink) return 0;
+        long long total = 0;
+        while (buildLevelGraph(source, sink)) {
+            total += blockingFlow(source, sink);
+            phases++;
+        }
+        return total;
+    }
+};
+
+#endif // AUGMENTING_PATHS_HPP
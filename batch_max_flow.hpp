@@ -0,0 +1,147 @@
+#ifndef BATCH_MAX_FLOW_HPP
+#define BATCH_MAX_FLOW_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "augmenting_paths.hpp"
+#include "flow_graph.hpp"
+#include "flow_result.hpp"
+
+struct FlowQuery {
+    NodeId source, sink;
+};
+
+// Runs many independent max flow queries over one graph on a pool of
+// threads. The graph is only read, so all workers share it; each worker owns
+// one residual buffer and one Solver, reused from query to query, so a batch
+// allocates per thread rather than per query. Queries are handed out through
+// an atomic counter, so a few expensive pairs do not leave the other threads
+// idle.
+//
+// The pool starts with the first run() and lives as long as the object, so
+// callers that run many small batches (the Gomory-Hu build runs one per
+// round) pay for threads and residual buffers once. The calling thread
+// works too. run() must not be called from two threads at once.
+//
+// Solver is any augmenting-path class from augmenting_paths.hpp (anything
+// with maxFlow(s, t), augmentations and arcScans).
+template <typename Solver = Dinic>
+class BatchMaxFlow {
+private:
+    using OnSolved = std::function<void(size_t, const FlowResult &, const std::vector<int> &)>;
+
+    struct Worker {
+        std::vector<int> residual;
+        Solver solver;
+
+        explicit Worker(const FlowGraph &graph) : solver(graph, residual) {}
+    };
+
+    const FlowGraph &graph;
+    std::vector<std::unique_ptr<Worker>> workers;   // workers[0] belongs to the calling thread
+    std::vector<std::thread> pool;
+
+    // The batch being run, published under mutex by bumping batch
+    const std::vector<FlowQuery> *queries = nullptr;
+    std::vector<FlowResult> *results = nullptr;
+    const OnSolved *onSolved = nullptr;
+    std::atomic<size_t> nextQuery{0};
+
+    std::mutex mutex;
+    std::condition_variable wake, finished;
+    unsigned long long batch = 0;
+    unsigned busy = 0;
+    bool stopping = false;
+
+    void drain(Worker &worker) {
+        for (size_t i; (i = nextQuery.fetch_add(1)) < queries->size();) {
+            const FlowQuery &query = (*queries)[i];
+            FlowResult &result = (*results)[i];
+            worker.residual.assign(graph.capacity.begin(), graph.capacity.end());
+            if (query.source < graph.numNodes && query.sink < graph.numNodes) {
+                timeSolve(result.stats, [&] { result.value = worker.solver.maxFlow(query.source, query.sink); });
+                result.stats.augmentations = worker.solver.augmentations;
+                result.stats.arcScans = worker.solver.arcScans;
+            }
+            (*onSolved)(i, result, worker.residual);
+        }
+    }
+
+    void serve(Worker &worker) {
+        unsigned long long served = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [&] { return stopping || batch != served; });
+            if (stopping) return;
+            served = batch;
+            lock.unlock();
+            drain(worker);
+            lock.lock();
+            if (--busy == 0) finished.notify_one();
+        }
+    }
+
+    void startPool() {
+        unsigned numThreads = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned t = 0; t < numThreads; t++) workers.push_back(std::make_unique<Worker>(graph));
+        for (unsigned t = 1; t < numThreads; t++) pool.emplace_back([this, t] { serve(*workers[t]); });
+    }
+
+public:
+    unsigned threads;               // 0 uses every hardware thread; read when the pool starts
+
+    explicit BatchMaxFlow(const FlowGraph &g, unsigned numThreads = 0) : graph(g), threads(numThreads) {}
+
+    BatchMaxFlow(const BatchMaxFlow &) = delete;
+    BatchMaxFlow &operator=(const BatchMaxFlow &) = delete;
+
+    ~BatchMaxFlow() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &thread : pool) thread.join();
+    }
+
+    // Solves every query and returns the results in query order. Only value
+    // and stats are filled in; per-arc flows of thousands of queries would
+    // not fit in memory. onSolved(index, result, residual) runs on the worker
+    // right after each solve, while its residual still holds that flow; it
+    // must be safe to call from several threads at once.
+    std::vector<FlowResult> run(const std::vector<FlowQuery> &batchQueries, const OnSolved &batchOnSolved) {
+        std::vector<FlowResult> batchResults(batchQueries.size());
+        if (workers.empty()) startPool();
+        queries = &batchQueries;
+        results = &batchResults;
+        onSolved = &batchOnSolved;
+        nextQuery = 0;
+
+        // Helpers are only woken when there is more than one query for them
+        bool helped = !pool.empty() && batchQueries.size() > 1;
+        if (helped) {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy = (unsigned)pool.size();
+            batch++;
+        }
+        if (helped) wake.notify_all();
+        drain(*workers[0]);
+        if (helped) {
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait(lock, [&] { return busy == 0; });
+        }
+        return batchResults;
+    }
+
+    std::vector<FlowResult> run(const std::vector<FlowQuery> &batchQueries) {
+        return run(batchQueries, [](size_t, const FlowResult &, const std::vector<int> &) {});
+    }
+};
+
+#endif // BATCH_MAX_FLOW_HPP
@@ -0,0 +1,36 @@
+#ifndef COMMAND_LINE_HPP
+#define COMMAND_LINE_HPP
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+// Strict option values: the whole string must be one number, so "--threads="
+// or "--seed=12abc" is an error rather than an exception or a silent zero.
+
+// Whole string as a finite number
+inline bool parseNumber(const std::string &text, double &value) {
+    char *end = nullptr;
+    errno = 0;
+    value = std::strtod(text.c_str(), &end);
+    return !text.empty() && end == text.c_str() + text.size() && errno == 0 && std::isfinite(value);
+}
+
+// Whole string as a base-10 integer within [low, high]
+inline bool parseInteger(const std::string &text, long long &value, long long low, long long high) {
+    char *end = nullptr;
+    errno = 0;
+    value = std::strtoll(text.c_str(), &end, 10);
+    return !text.empty() && end == text.c_str() + text.size() && errno == 0 && value >= low && value <= high;
+}
+
+// Whole string as an unsigned 64-bit integer, e.g. a random seed
+inline bool parseUnsigned(const std::string &text, unsigned long long &value) {
+    char *end = nullptr;
+    errno = 0;
+    value = std::strtoull(text.c_str(), &end, 10);
+    return !text.empty() && text[0] != '-' && end == text.c_str() + text.size() && errno == 0;
+}
+
+#endif // COMMAND_LINE_HPP
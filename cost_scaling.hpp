@@ -0,0 +1,130 @@
+#ifndef COST_SCALING_HPP
+#define COST_SCALING_HPP
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "flow_graph.hpp"
+#include "push_relabel.hpp"
+
+// Goldberg-Tarjan cost-scaling min-cost max flow on a FlowGraph.
+//
+// A maximum flow is found first with push-relabel. Its residual graph is then
+// turned into a minimum-cost one by solving a min-cost circulation with cost
+// scaling: costs are multiplied by n + 1 and each refine(eps) phase saturates
+// every arc of negative reduced cost, then pushes the resulting excess along
+// admissible arcs (residual > 0, reduced cost < 0), lowering node prices when
+// a node has none left. After the eps = 1 phase the flow is 1/(n + 1)-optimal
+// in the original integer costs, which makes it optimal. Circulations do not
+// change the flow value, so the maximum flow is kept.
+class CostScalingMinCostFlow {
+private:
+    const FlowGraph &graph;
+    std::vector<int> &residual;
+    int n;
+
+    std::vector<long long> price, excess;
+    std::vector<int> currentArc;
+    long long costScale = 1;
+
+    long long reducedCost(NodeId u, int a) const {
+        return graph.cost[a] * costScale + price[u] - price[graph.head[a]];
+    }
+
+    void pushFlow(NodeId u, int a, int amount) {
+        residual[a] -= amount;
+        residual[graph.reverse[a]] += amount;
+        excess[u] -= amount;
+        excess[graph.head[a]] += amount;
+    }
+
+    void refine(long long eps) {
+        std::queue<NodeId> active;
+
+        // Saturating every arc of negative reduced cost makes the flow 0-optimal
+        // at the price of creating excesses and deficits
+        for (NodeId u = 0; u < graph.numNodes; u++) {
+            for (int a = graph.offset[u]; a < graph.offset[u + 1]; a++) {
+                if (residual[a] > 0 && reducedCost(u, a) < 0) pushFlow(u, a, residual[a]);
+            }
+        }
+        arcScans += graph.numArcs();
+        for (NodeId u = 0; u < graph.numNodes; u++) {
+            currentArc[u] = graph.offset[u];
+            if (excess[u] > 0) active.push(u);
+        }
+
+        while (!active.empty()) {
+            NodeId u = active.front();
+            active.pop();
+
+            while (excess[u] > 0) {
+                int &a = currentArc[u];
+                if (a == graph.offset[u + 1]) {
+                    // Relabel: the best arc becomes admissible with reduced cost -eps
+                    long long best = std::numeric_limits<long long>::min();
+                    arcScans += graph.offset[u + 1] - graph.offset[u];
+                    for (int b = graph.offset[u]; b < graph.offset[u + 1]; b++) {
+                        if (residual[b] > 0) best = std::max(best, price[graph.head[b]] - graph.cost[b] * costScale);
+                    }
+                    if (best == std::numeric_limits<long long>::min()) break; // No residual arc out of u
+                    price[u] = best - eps;
+                    relabels++;
+                    a = graph.offset[u];
+                    continue;
+                }
+
+                arcScans++;
+                if (residual[a] > 0 && reducedCost(u, a) < 0) {
+                    NodeId v = graph.head[a];
+                    bool wasActive = excess[v] > 0;
+                    pushFlow(u, a, (int)std::min<long long>(excess[u], residual[a]));
+                    pushes++;
+                    if (!wasActive && excess[v] > 0) active.push(v);
+                    if (excess[u] == 0) break;
+                }
+                a++;
+            }
+        }
+    }
+
+public:
+    // Work done by the last solve
+    long long phases = 0, pushes = 0, relabels = 0, arcScans = 0;
+
+    CostScalingMinCostFlow(const FlowGraph &g, std::vector<int> &residualCapacity)
+        : graph(g), residual(residualCapacity), n(g.numNodes) {}
+
+    // Solves from the current residual capacities; returns (flow, cost) in the
+    // same form as MinCostMaxFlow::minCostMaxFlow
+    std::pair<int, int> minCostMaxFlow(NodeId source, NodeId sink) {
+        phases = pushes = relabels = arcScans = 0;
+
+        PushRelabel maxFlowSolver(graph, residual);
+        long long flowValue = maxFlowSolver.maxFlow(source, sink);
+        pushes = maxFlowSolver.pushes;
+        arcScans = maxFlowSolver.arcScans;
+
+        price.assign(n, 0);
+        excess.assign(n, 0);
+        currentArc.assign(n, 0);
+        costScale = (long long)n + 1;
+
+        long long eps = 0;
+        for (int c : graph.cost) eps = std::max(eps, (long long)std::abs(c) * costScale);
+        while (eps > 1) {
+            eps = std::max(1LL, eps / 8);
+            refine(eps);
+            phases++;
+        }
+
+        long long totalCost = 0;
+        for (int a : graph.inputArc) totalCost += (long long)(graph.capacity[a] - residual[a]) * graph.cost[a];
+        return std::make_pair((int)flowValue, (int)totalCost);
+    }
+};
+
+#endif // COST_SCALING_HPP
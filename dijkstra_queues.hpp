@@ -0,0 +1,209 @@
+#ifndef DIJKSTRA_QUEUES_HPP
+#define DIJKSTRA_QUEUES_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "flow_graph.hpp"
+
+// Priority queues for Dijkstra on non-negative integer distances. Keys are
+// unsigned and not checked here, so callers must never push a negative
+// distance. All three share one interface and use lazy deletion: a node is
+// pushed again when its distance drops, and the caller skips entries whose
+// key no longer matches dist[node]. clear() keeps the allocated memory, so
+// a queue reused across searches stops allocating after the first few.
+
+// Binary heap, the general fallback: O(log n) per operation
+class BinaryHeapQueue {
+private:
+    std::vector<std::pair<uint32_t, NodeId>> heap;
+
+public:
+    void clear() { heap.clear(); }
+    bool empty() const { return heap.empty(); }
+
+    void push(uint32_t key, NodeId node) {
+        heap.push_back({key, node});
+        std::push_heap(heap.begin(), heap.end(), std::greater<std::pair<uint32_t, NodeId>>());
+    }
+
+    std::pair<uint32_t, NodeId> pop() {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<std::pair<uint32_t, NodeId>>());
+        auto top = heap.back();
+        heap.pop_back();
+        return top;
+    }
+};
+
+// Dial's bucket queue: one bucket per distance value, scanned upwards, so
+// push and pop are O(1) plus the scan over empty buckets. The scan covers
+// the largest distance settled, so this pays off when arc costs are small.
+// Buckets are singly linked lists threaded through one entry array.
+class DialQueue {
+private:
+    std::vector<int> bucketHead;            // First entry of each bucket, -1 if empty
+    std::vector<std::pair<NodeId, int>> entries; // (node, next entry in the bucket)
+    size_t current = 0, highest = 0, count = 0;
+
+public:
+    void clear() {
+        if (!bucketHead.empty()) std::fill(bucketHead.begin(), bucketHead.begin() + std::min(highest + 1, bucketHead.size()), -1);
+        entries.clear();
+        current = highest = count = 0;
+    }
+
+    bool empty() const { return count == 0; }
+
+    void push(uint32_t key, NodeId node) {
+        if (key >= bucketHead.size()) bucketHead.resize(std::max<size_t>(key + 1, 2 * bucketHead.size()), -1);
+        entries.push_back({node, bucketHead[key]});
+        bucketHead[key] = (int)entries.size() - 1;
+        highest = std::max<size_t>(highest, key);
+        count++;
+    }
+
+    // Keys must not drop below the last one popped, as in Dijkstra
+    std::pair<uint32_t, NodeId> pop() {
+        while (bucketHead[current] == -1) current++;
+        int e = bucketHead[current];
+        bucketHead[current] = entries[e].second;
+        count--;
+        return {(uint32_t)current, entries[e].first};
+    }
+};
+
+// Radix heap: bucket i holds keys whose highest bit differing from the last
+// popped key is bit i - 1. Every entry moves to a lower bucket at most 32
+// times, so operations are O(log C) amortised with no comparisons between
+// entries. Works for any key range, as long as keys are monotone.
+class RadixHeapQueue {
+private:
+    std::vector<std::pair<uint32_t, NodeId>> buckets[33];
+    uint32_t last = 0;
+    size_t count = 0;
+
+    static int bucketOf(uint32_t key, uint32_t last) {
+        uint32_t diff = key ^ last;
+        if (diff == 0) return 0;
+#if defined(__GNUC__) || defined(__clang__)
+        return 32 - __builtin_clz(diff);
+#else
+        int width = 0;
+        while (diff) {
+            diff >>= 1;
+            width++;
+        }
+        return width;
+#endif
+    }
+
+public:
+    void clear() {
+        for (auto &bucket : buckets) bucket.clear();
+        last = 0;
+        count = 0;
+    }
+
+    bool empty() const { return count == 0; }
+
+    void push(uint32_t key, NodeId node) {
+        buckets[bucketOf(key, last)].push_back({key, node});
+        count++;
+    }
+
+    std::pair<uint32_t, NodeId> pop() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) i++;
+            uint32_t smallest = buckets[i][0].first;
+            for (const auto &entry : buckets[i]) smallest = std::min(smallest, entry.first);
+            last = smallest;
+            for (const auto &entry : buckets[i]) buckets[bucketOf(entry.first, last)].push_back(entry);
+            buckets[i].clear();
+        }
+        auto top = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        return top;
+    }
+};
+
+enum class DijkstraQueue { Auto, BinaryHeap, Dial, RadixHeap };
+
+inline const char *dijkstraQueueName(DijkstraQueue queue) {
+    switch (queue) {
+    case DijkstraQueue::BinaryHeap: return "binary-heap";
+    case DijkstraQueue::Dial: return "dial";
+    case DijkstraQueue::RadixHeap: return "radix-heap";
+    default: return "auto";
+    }
+}
+
+// Largest arc cost for which Auto picks Dial's buckets over the radix heap.
+// Dial scans one bucket per distance value up to the largest distance it
+// settles, which is bounded only by path length times the largest cost.
+// With costs this small that scan stays of the order of the nodes settled,
+// and Dial matched the radix heap in flow_benchmark. Larger costs spread
+// distances over more empty buckets, so the radix heap, whose cost does not
+// depend on the key range, becomes the safer choice. The threshold is an
+// empirical cut-off, not a bound.
+const int DIAL_MAX_ARC_COST = 64;
+
+// Negative costs fall back to the binary heap, which does not rely on the
+// keys of one search growing from a small start
+inline DijkstraQueue chooseDijkstraQueue(const FlowGraph &graph) {
+    int maxCost = 0;
+    for (int a : graph.inputArc) {
+        if (graph.cost[a] < 0) return DijkstraQueue::BinaryHeap;
+        maxCost = std::max(maxCost, graph.cost[a]);
+    }
+    return maxCost <= DIAL_MAX_ARC_COST ? DijkstraQueue::Dial : DijkstraQueue::RadixHeap;
+}
+
+// Scratch state of repeated single-source searches: distances, the arc
+// each node was reached by and the queues. Sized once per graph; between
+// searches reset() restores only the entries the last search touched, so a
+// search that stays local costs nothing for the rest of the graph.
+class DijkstraWorkspace {
+public:
+    static constexpr int INF = 1000000000;
+
+    std::vector<int> dist;          // INF when not reached
+    std::vector<int> parentArc;     // -1 when not reached
+    std::vector<NodeId> touched;    // Nodes reached by the last search, in order
+    BinaryHeapQueue binaryHeap;
+    DialQueue dial;
+    RadixHeapQueue radixHeap;
+
+    // Makes every node unreached, keeping the memory when the size matches
+    void prepare(int numNodes) {
+        if ((int)dist.size() != numNodes) {
+            dist.assign(numNodes, INF);
+            parentArc.assign(numNodes, -1);
+            touched.clear();
+        } else {
+            reset();
+        }
+    }
+
+    void reset() {
+        for (NodeId u : touched) {
+            dist[u] = INF;
+            parentArc[u] = -1;
+        }
+        touched.clear();
+    }
+
+    // Lowers dist[v] to d via arc a; false if it was not an improvement
+    bool relax(NodeId v, int d, int a) {
+        if (d >= dist[v]) return false;
+        if (dist[v] == INF) touched.push_back(v);
+        dist[v] = d;
+        parentArc[v] = a;
+        return true;
+    }
+};
+
+#endif // DIJKSTRA_QUEUES_HPP
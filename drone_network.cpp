@@ -1,94 +1,202 @@
 #include <iostream>
 #include <vector>
-#include <unordered_map>
-#include <fstream>
-#include <cstdlib> // For random numbers
-#include <ctime>   // For seeding randomness
-#include "json.hpp"  
+#include <chrono>
+#include <string>
+#include <limits>
+#include "network_generator.hpp"
+#include "network_writer.hpp"
+#include "command_line.hpp"
 using namespace std;
-using json = nlohmann::json;
 
-class DroneDeliveryNetwork {
+class DroneDeliveryNetwork : public NetworkSink {
 private:
-    unordered_map<string, vector<pair<string, int>>> adjList; // Adjacency list
+    NodeInterner names;                           // Node name <-> dense id
+    vector<vector<DroneLink>> adjList;            // Adjacency list indexed by node id
 
 public:
-    DroneDeliveryNetwork() {
-        srand(time(0)); // Seed for random numbers
+    NodeId addNode(const string& name) {
+        NodeId id = names.intern(name);
+        if (id >= adjList.size()) adjList.resize(id + 1);
+        return id;
     }
 
-    void addEdge(const string& u, const string& v, int capacity) {
-        adjList[u].push_back({v, capacity});
+    void addEdge(NodeId u, const DroneLink& link) {
+        adjList[u].push_back(link);
     }
 
-    void generateTestNetwork(int numWarehouses = 2, int numDrones = 2, int numDestinations = 2) {
+    bool begin(const NetworkLayout& layout) override {
+        names = NodeInterner();
         adjList.clear();
-        string source = "Source", sink = "Sink";
+        for (NodeId u = 0; u < layout.numNodes(); u++) addNode(layout.name(u));
+        return true;
+    }
 
-        // Add warehouses as sources
-        for (int i = 0; i < numWarehouses; i++) {
-            string warehouse = "Warehouse_" + to_string(i);
-            addEdge(source, warehouse, rand() % 11 + 5); // Capacity 5-15
-        }
+    void node(NodeId from, const DroneLink* links, size_t count) override {
+        adjList[from].assign(links, links + count);
+    }
 
-        // Add drones as intermediate nodes
-        for (int j = 0; j < numDrones; j++) {
-            string drone = "Drone_" + to_string(j);
-            for (int i = 0; i < numWarehouses; i++) {
-                string warehouse = "Warehouse_" + to_string(i);
-                addEdge(warehouse, drone, rand() % 9 + 2); // Capacity 2-10
-            }
-            for (int k = 0; k < numDestinations; k++) {
-                string destination = "Destination_" + to_string(k);
-                addEdge(drone, destination, rand() % 5 + 1); // Capacity 1-5
-            }
-        }
+    void generateTestNetwork(int numWarehouses = 2, int numDrones = 2, int numDestinations = 2, uint64_t seed = 1) {
+        GeneratorOptions options;
+        options.numWarehouses = numWarehouses;
+        options.numDrones = numDrones;
+        options.numDestinations = numDestinations;
+        options.seed = seed;
+        options.threads = 1;
+        ParallelNetworkGenerator(options).generate(*this);
+    }
 
-        // Add destinations as sinks
-        for (int k = 0; k < numDestinations; k++) {
-            string destination = "Destination_" + to_string(k);
-            addEdge(destination, sink, rand() % 6 + 5); // Capacity 5-10
+    // Streams the adjacency lists out without building a JSON document
+    void saveToFile(const string& filename = "data/network.json", bool compact = false) {
+        JsonNetworkWriter writer;
+        if (!writer.open(filename, compact)) {
+            cerr << "Error: Unable to save network!" << endl;
+            return;
+        }
+        for (NodeId u = 0; u < adjList.size(); u++) {
+            if (adjList[u].empty()) continue;
+            writer.beginNode(names.name(u));
+            for (auto& edge : adjList[u]) writer.edge(names.name(edge.to), edge);
+            writer.endNode();
+        }
+        if (!writer.close()) {
+            cerr << "Error: Unable to save network!" << endl;
+            return;
         }
+        cout << "Network saved to " << filename << endl;
     }
 
-    void saveToFile(const string& filename = "data/network.json") {
-        json networkJson;
+    // Writes the memory-mappable binary format read by every solver
+    void saveBinary(const string& filename) {
+        vector<int> arcsPerNode(adjList.size(), 0);
+        uint64_t numEdges = 0, nameBytes = 0;
+        for (NodeId u = 0; u < adjList.size(); u++) {
+            nameBytes += names.name(u).size();
+            arcsPerNode[u] += adjList[u].size();
+            for (auto& edge : adjList[u]) arcsPerNode[edge.to]++;
+            numEdges += adjList[u].size();
+        }
 
-        for (auto& node : adjList) {
-            json edges;
-            for (auto& edge : node.second) {
-                edges.push_back({{"destination", edge.first}, {"capacity", edge.second}});
+        FlowGraphFileWriter writer;
+        bool ok = writer.create(filename, arcsPerNode, numEdges, nameBytes);
+        if (ok) {
+            for (NodeId u = 0; u < adjList.size(); u++) {
+                for (auto& edge : adjList[u]) writer.addEdge(u, edge.to, edge.capacity, edge.cost);
             }
-            networkJson[node.first] = edges;
+            for (NodeId u = 0; u < adjList.size(); u++) writer.addName(names.name(u));
+            ok = writer.finish();
         }
-
-        ofstream file(filename);
-        if (!file) {
+        if (!ok) {
             cerr << "Error: Unable to save network!" << endl;
             return;
         }
-
-        file << networkJson.dump(4); // Pretty print with an indent of 4 spaces
-        file.close();
         cout << "Network saved to " << filename << endl;
     }
 
     void printNetwork() {
         cout << "Drone Delivery Flow Network:\n";
-        for (auto& node : adjList) {
-            cout << node.first << " -> ";
-            for (auto& edge : node.second) {
-                cout << "(" << edge.first << ", capacity=" << edge.second << ") ";
+        for (NodeId u = 0; u < adjList.size(); u++) {
+            if (adjList[u].empty()) continue;
+            cout << names.name(u) << " -> ";
+            for (auto& edge : adjList[u]) {
+                cout << "(" << names.name(edge.to) << ", capacity=" << edge.capacity << ", cost=" << edge.cost << ") ";
             }
             cout << endl;
         }
     }
 };
 
-int main() {
-    DroneDeliveryNetwork network;
-    network.generateTestNetwork();
-    network.printNetwork();
-    network.saveToFile("network.json"); // Save to JSON file
+bool parseTopology(const string& name, Topology& topology) {
+    if (name == "full") topology = Topology::FullMesh;
+    else if (name == "knearest") topology = Topology::KNearest;
+    else if (name == "grid") topology = Topology::Grid;
+    else return false;
+    return true;
+}
+
+// Numeric generator options. Returns false if key is not one of them;
+// otherwise valid tells whether the value parsed and is in range.
+bool numericOption(const string& key, const string& value, GeneratorOptions& options, bool& valid) {
+    long long count = 0;
+    int* target = key == "--warehouses" ? &options.numWarehouses
+                : key == "--drones" ? &options.numDrones
+                : key == "--destinations" ? &options.numDestinations
+                : key == "--k" ? &options.neighbours
+                : nullptr;
+    if (target) {
+        valid = parseInteger(value, count, 1, numeric_limits<int>::max());
+        if (valid) *target = (int)count;
+    } else if (key == "--area") {
+        valid = parseNumber(value, options.areaKm) && options.areaKm > 0;
+    } else if (key == "--seed") {
+        unsigned long long seed = 0;
+        valid = parseUnsigned(value, seed);
+        options.seed = seed;
+    } else if (key == "--threads") {
+        valid = parseInteger(value, count, 0, 1024);
+        options.threads = (unsigned)count;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    // Without options, build the small demo network in memory as before
+    if (argc == 1) {
+        DroneDeliveryNetwork network;
+        network.generateTestNetwork();
+        network.printNetwork();
+        network.saveToFile("network.json"); // Save to JSON file
+        return 0;
+    }
+
+    GeneratorOptions options;
+    string filename = "network.json";
+    bool compact = false, binary = false;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        size_t eq = arg.find('=');
+        string key = arg.substr(0, eq), value = eq == string::npos ? "" : arg.substr(eq + 1);
+        bool valid = true;
+        if (numericOption(key, value, options, valid)) {
+            if (!valid) {
+                cerr << "Error: Invalid value for " << key << ": " << value << endl;
+                return 1;
+            }
+        } else if (arg == "--compact") compact = true;
+        else if (arg == "--binary") binary = true;
+        else if (key == "--topology") {
+            if (!parseTopology(value, options.topology)) {
+                cerr << "Error: Unknown topology " << value << " (expected full, knearest or grid)" << endl;
+                return 1;
+            }
+        } else if (arg.rfind("--", 0) == 0) {
+            cerr << "Error: Unknown option " << arg << endl;
+            return 1;
+        } else {
+            filename = arg;
+        }
+    }
+
+    auto start = chrono::high_resolution_clock::now();
+    ParallelNetworkGenerator generator(options);
+    uint64_t numEdges = 0;
+    bool saved;
+    if (binary) {
+        saved = writeBinaryNetwork(generator, filename, numEdges);
+    } else {
+        JsonNetworkSink sink(filename, compact);
+        saved = generator.generate(sink);
+        numEdges = sink.edgesWritten;
+    }
+    if (!saved) {
+        cerr << "Error: Unable to save network!" << endl;
+        return 1;
+    }
+    double seconds = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+
+    cout << "Generated " << generator.networkLayout().numNodes() << " nodes and " << numEdges
+         << " edges in " << seconds << " s" << endl;
+    cout << "Network saved to " << filename << endl;
     return 0;
 }
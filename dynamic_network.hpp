@@ -0,0 +1,279 @@
+#ifndef DYNAMIC_NETWORK_HPP
+#define DYNAMIC_NETWORK_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "flow_graph.hpp"
+
+enum class NodeRole { Warehouse, Drone, Destination };
+
+// A FlowGraph that can change in memory while solvers keep using it.
+//
+// The arcs live in vectors laid out like FlowGraphBuilder output, except that
+// every node's range ends with a few spare slots. graph() views these
+// vectors, so a solver holding the graph sees every change without a copy:
+//   - a spare slot is a self-loop with zero capacity, which no solver ever
+//     uses, so it costs a scan and nothing else;
+//   - addEdge fills a spare slot at both ends in O(1);
+//   - removeEdge and removeNode leave tombstones: the arcs keep their slots
+//     with zero capacity until the next compaction;
+//   - compact() rebuilds the layout from the live edges with fresh slack. It
+//     runs on its own when an edge finds no spare slot, and maybeCompact()
+//     runs it once tombstones pass maxDeadFraction of the used slots.
+// Node ids never change; removed nodes stay as empty ranges. Edge and arc
+// indices hold until a compaction, which bumps generation and renumbers the
+// live edges in their original order. Solvers size their residual arrays
+// from graph().numArcs(), so size them again after any change.
+class DynamicFlowNetwork {
+private:
+    struct Edge {
+        NodeId from, to;
+        int capacity, cost;
+    };
+
+    std::vector<int> offset, capacity, cost, reverse, inputArc;
+    std::vector<NodeId> head;
+    std::vector<int> usedEnd;               // Used slots of u are [offset[u], usedEnd[u])
+    std::vector<char> deadArc, removedNode;
+    std::vector<uint32_t> nameOffset;
+    std::vector<char> nameData;
+    std::vector<NodeId> nameOrder;
+    FlowGraph view;
+    int minSlack;
+    size_t usedArcs = 0, deadArcs = 0;
+    int nextRoleIndex[3] = {0, 0, 0};
+
+    std::string_view name(NodeId node) const {
+        return std::string_view(nameData.data() + nameOffset[node], nameOffset[node + 1] - nameOffset[node]);
+    }
+
+    // Points the FlowGraph at the current vectors. Cheap, and needed after
+    // anything that may have reallocated them.
+    void publish() {
+        view.numNodes = (NodeId)usedEnd.size();
+        view.offset = GraphArray<int>::view(offset.data(), offset.size());
+        view.head = GraphArray<NodeId>::view(head.data(), head.size());
+        view.capacity = GraphArray<int>::view(capacity.data(), capacity.size());
+        view.cost = GraphArray<int>::view(cost.data(), cost.size());
+        view.reverse = GraphArray<int>::view(reverse.data(), reverse.size());
+        view.inputArc = GraphArray<int>::view(inputArc.data(), inputArc.size());
+        view.nameOffset = GraphArray<uint32_t>::view(nameOffset.data(), nameOffset.size());
+        view.nameData = GraphArray<char>::view(nameData.data(), nameData.size());
+        view.nameOrder = GraphArray<NodeId>::view(nameOrder.data(), nameOrder.size());
+    }
+
+    void appendSpareSlots(NodeId node, int count) {
+        for (int i = 0; i < count; i++) {
+            int a = (int)head.size();
+            head.push_back(node);
+            capacity.push_back(0);
+            cost.push_back(0);
+            reverse.push_back(a);
+            deadArc.push_back(false);
+        }
+    }
+
+    // Grows with the degree, so a busy node does not force a compaction
+    // every few insertions
+    int slackFor(int degree) const { return std::max(minSlack, degree / 2); }
+
+    // Lays out the given edges in input order, each node followed by its slack
+    void rebuild(const std::vector<Edge> &edges) {
+        NodeId n = (NodeId)usedEnd.size();
+        std::vector<int> degree(n, 0);
+        for (const Edge &e : edges) {
+            degree[e.from]++;
+            degree[e.to]++;
+        }
+
+        offset.assign(1, 0);
+        head.clear();
+        capacity.clear();
+        cost.clear();
+        reverse.clear();
+        deadArc.clear();
+        for (NodeId u = 0; u < n; u++) {
+            usedEnd[u] = offset[u];
+            appendSpareSlots(u, degree[u] + (removedNode[u] ? 0 : slackFor(degree[u])));
+            offset.push_back((int)head.size());
+        }
+
+        inputArc.clear();
+        for (const Edge &e : edges) placeEdge(e.from, e.to, e.capacity, e.cost);
+        usedArcs = 2 * edges.size();
+        deadArcs = 0;
+        generation++;
+    }
+
+    int placeEdge(NodeId from, NodeId to, int edgeCapacity, int edgeCost) {
+        int a = usedEnd[from]++;
+        int b = usedEnd[to]++;
+        head[a] = to;
+        capacity[a] = edgeCapacity;
+        cost[a] = edgeCost;
+        reverse[a] = b;
+        head[b] = from;
+        capacity[b] = 0;
+        cost[b] = -edgeCost;
+        reverse[b] = a;
+        inputArc.push_back(a);
+        return (int)inputArc.size() - 1;
+    }
+
+    int spareSlots(NodeId node) const { return offset[node + 1] - usedEnd[node]; }
+
+    bool validNode(NodeId node) const { return node < usedEnd.size() && !removedNode[node]; }
+
+    void liveEdges(std::vector<Edge> &edges) const {
+        edges.clear();
+        for (int a : inputArc) {
+            if (!deadArc[a]) edges.push_back({head[reverse[a]], head[a], capacity[a], cost[a]});
+        }
+    }
+
+public:
+    long long generation = 0;               // Bumped by every compaction
+    double maxDeadFraction = 0.25;          // Tombstone share that makes maybeCompact() rebuild
+
+    explicit DynamicFlowNetwork(const FlowGraph &base, int slackPerNode = 4) : minSlack(std::max(1, slackPerNode)) {
+        nameOffset.assign(base.nameOffset.begin(), base.nameOffset.end());
+        nameData.assign(base.nameData.begin(), base.nameData.end());
+        nameOrder.assign(base.nameOrder.begin(), base.nameOrder.end());
+        usedEnd.assign(base.numNodes, 0);
+        removedNode.assign(base.numNodes, false);
+        if (nameOffset.empty()) nameOffset.push_back(0);
+
+        std::vector<Edge> edges(base.numEdges());
+        for (int i = 0; i < base.numEdges(); i++) {
+            int a = base.inputArc[i];
+            edges[i] = {base.tail(a), base.head[a], base.capacity[a], base.cost[a]};
+        }
+        rebuild(edges);
+        generation = 0;
+        publish();
+    }
+
+    DynamicFlowNetwork(const DynamicFlowNetwork &) = delete;
+    DynamicFlowNetwork &operator=(const DynamicFlowNetwork &) = delete;
+
+    // The live graph; the reference stays valid for the network's lifetime
+    const FlowGraph &graph() const { return view; }
+
+    NodeId nodeId(std::string_view nodeName) const { return view.nodeId(nodeName); }
+    size_t numLiveEdges() const { return (usedArcs - deadArcs) / 2; }
+
+    // Adds a node with the given name, or returns the live node that has it
+    NodeId addNode(std::string_view nodeName) {
+        NodeId existing = nodeId(nodeName);
+        if (existing != INVALID_NODE) return existing;
+
+        NodeId node = (NodeId)usedEnd.size();
+        usedEnd.push_back(offset.back());
+        removedNode.push_back(false);
+        appendSpareSlots(node, minSlack);
+        offset.push_back((int)head.size());
+
+        nameData.insert(nameData.end(), nodeName.begin(), nodeName.end());
+        nameOffset.push_back((uint32_t)nameData.size());
+        auto it = std::lower_bound(nameOrder.begin(), nameOrder.end(), nodeName,
+                                   [this](NodeId u, std::string_view key) { return name(u) < key; });
+        nameOrder.insert(it, node);
+        publish();
+        return node;
+    }
+
+    // Adds the next free Warehouse_<i>, Drone_<i> or Destination_<i>
+    NodeId addNode(NodeRole role) {
+        static const char *const prefixes[] = {"Warehouse_", "Drone_", "Destination_"};
+        int &index = nextRoleIndex[(int)role];
+        std::string nodeName;
+        do {
+            nodeName = prefixes[(int)role] + std::to_string(index++);
+        } while (nodeId(nodeName) != INVALID_NODE);
+        return addNode(nodeName);
+    }
+
+    // Tombstones the node and every edge touching it. Its name is free again.
+    bool removeNode(NodeId node) {
+        if (!validNode(node)) {
+            std::cerr << "Cannot remove unknown node " << node << std::endl;
+            return false;
+        }
+        for (int a = offset[node]; a < usedEnd[node]; a++) {
+            if (deadArc[a]) continue;
+            int b = reverse[a];
+            deadArc[a] = deadArc[b] = true;
+            capacity[a] = capacity[b] = 0;
+            deadArcs += 2;
+        }
+        removedNode[node] = true;
+        nameOrder.erase(std::find(nameOrder.begin(), nameOrder.end(), node));
+        publish();
+        return true;
+    }
+
+    // Adds an edge and returns its index, or -1 if an endpoint is unknown.
+    // Compacts first when an endpoint has no spare slot left.
+    int addEdge(NodeId from, NodeId to, int edgeCapacity, int edgeCost = DEFAULT_EDGE_COST) {
+        if (!validNode(from) || !validNode(to)) {
+            std::cerr << "Cannot add edge " << from << " -> " << to << ": unknown node" << std::endl;
+            return -1;
+        }
+        bool fits = from == to ? spareSlots(from) >= 2 : spareSlots(from) >= 1 && spareSlots(to) >= 1;
+        if (!fits) {
+            std::vector<Edge> edges;
+            liveEdges(edges);
+            edges.push_back({from, to, edgeCapacity, edgeCost});
+            rebuild(edges);
+            publish();
+            return (int)inputArc.size() - 1;
+        }
+        int edge = placeEdge(from, to, edgeCapacity, edgeCost);
+        usedArcs += 2;
+        publish();
+        return edge;
+    }
+
+    bool removeEdge(int edge) {
+        if (edge < 0 || edge >= (int)inputArc.size() || deadArc[inputArc[edge]]) {
+            std::cerr << "Cannot remove unknown edge " << edge << std::endl;
+            return false;
+        }
+        int a = inputArc[edge];
+        deadArc[a] = deadArc[reverse[a]] = true;
+        capacity[a] = 0;
+        deadArcs += 2;
+        return true;
+    }
+
+    bool setCapacity(int edge, int edgeCapacity) {
+        if (edge < 0 || edge >= (int)inputArc.size() || deadArc[inputArc[edge]]) {
+            std::cerr << "Cannot change capacity of unknown edge " << edge << std::endl;
+            return false;
+        }
+        capacity[inputArc[edge]] = std::max(0, edgeCapacity);
+        return true;
+    }
+
+    // Drops every tombstone and resets the slack
+    void compact() {
+        std::vector<Edge> edges;
+        liveEdges(edges);
+        rebuild(edges);
+        publish();
+    }
+
+    // Compacts once tombstones make up maxDeadFraction of the used slots.
+    // Call it between solves; returns true if the indices changed.
+    bool maybeCompact() {
+        if (deadArcs == 0 || deadArcs < maxDeadFraction * usedArcs) return false;
+        compact();
+        return true;
+    }
+};
+
+#endif // DYNAMIC_NETWORK_HPP
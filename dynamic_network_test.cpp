@@ -0,0 +1,167 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "augmenting_paths.hpp"
+#include "dynamic_network.hpp"
+#include "flow_graph.hpp"
+
+using namespace std;
+
+// Regression test for DynamicFlowNetwork: random sequences of node and edge
+// insertions, removals, capacity changes and compactions, mirrored in a
+// plain edge list. After every step the live graph must pass
+// validateFlowGraph, map each edge index to the mirrored edge, resolve live
+// names only, and give the same max flow as a fresh FlowGraphBuilder build.
+
+struct MirrorEdge {
+    NodeId from, to;
+    int capacity, cost;
+    bool live;
+};
+
+struct Mirror {
+    vector<string> names;           // By node id; empty once removed
+    vector<MirrorEdge> edges;       // By current edge index
+
+    // A compaction renumbers the live edges in their original order
+    void compact() {
+        vector<MirrorEdge> live;
+        for (const MirrorEdge &e : edges) {
+            if (e.live) live.push_back(e);
+        }
+        edges = live;
+    }
+};
+
+long long maxFlow(const FlowGraph &graph, NodeId s, NodeId t) {
+    if (s == t) return 0;
+    vector<int> residual(graph.capacity.begin(), graph.capacity.end());
+    return Dinic(graph, residual).maxFlow(s, t);
+}
+
+// Empty if the network matches the mirror, otherwise what is wrong
+string checkNetwork(const DynamicFlowNetwork &network, const Mirror &mirror, NodeId s, NodeId t) {
+    const FlowGraph &graph = network.graph();
+    string problem;
+    if (!validateFlowGraph(graph, problem)) return problem;
+    if (graph.numNodes != mirror.names.size()) return "has " + to_string(graph.numNodes) + " nodes";
+    if (graph.numEdges() != (int)mirror.edges.size()) return "has " + to_string(graph.numEdges()) + " edge indices";
+
+    size_t live = 0;
+    for (size_t i = 0; i < mirror.edges.size(); i++) {
+        const MirrorEdge &e = mirror.edges[i];
+        if (!e.live) continue;
+        live++;
+        int a = graph.inputArc[i];
+        if (graph.tail(a) != e.from || graph.head[a] != e.to || graph.capacity[a] != e.capacity || graph.cost[a] != e.cost) {
+            return "edge " + to_string(i) + " does not match";
+        }
+    }
+    if (network.numLiveEdges() != live) return "counts " + to_string(network.numLiveEdges()) + " live edges";
+
+    FlowGraphBuilder builder;
+    for (NodeId u = 0; u < mirror.names.size(); u++) {
+        const string &name = mirror.names[u];
+        if (!name.empty() && network.nodeId(name) != u) return "name " + name + " does not resolve";
+        builder.addNode(name.empty() ? "removed_" + to_string(u) : name);
+    }
+    for (const MirrorEdge &e : mirror.edges) {
+        if (e.live) builder.addEdge(e.from, e.to, e.capacity, e.cost);
+    }
+    FlowGraph fresh = builder.build();
+    long long got = maxFlow(graph, s, t), expected = maxFlow(fresh, s, t);
+    if (got != expected) return "max flow " + to_string(got) + ", expected " + to_string(expected);
+    return "";
+}
+
+bool runTrial(int trial, mt19937 &rng) {
+    Mirror mirror;
+    int n = 2 + rng() % 6;
+    FlowGraphBuilder builder;
+    for (int u = 0; u < n; u++) {
+        mirror.names.push_back("n" + to_string(u));
+        builder.addNode(mirror.names.back());
+    }
+    int m = rng() % 10;
+    for (int i = 0; i < m; i++) {
+        MirrorEdge e = {(NodeId)(rng() % n), (NodeId)(rng() % n), (int)(rng() % 10), (int)(rng() % 5), true};
+        builder.addEdge(e.from, e.to, e.capacity, e.cost);
+        mirror.edges.push_back(e);
+    }
+    FlowGraph base = builder.build();
+    DynamicFlowNetwork network(base, 1 + rng() % 3);
+
+    int steps = 1 + rng() % 30;
+    for (int step = 0; step < steps; step++) {
+        vector<NodeId> liveNodes;
+        for (NodeId u = 0; u < mirror.names.size(); u++) {
+            if (!mirror.names[u].empty()) liveNodes.push_back(u);
+        }
+        vector<int> liveEdges;
+        for (size_t i = 0; i < mirror.edges.size(); i++) {
+            if (mirror.edges[i].live) liveEdges.push_back((int)i);
+        }
+        long long generation = network.generation;
+
+        int op = rng() % 8;
+        if (op == 0) {
+            NodeRole role = (NodeRole)(rng() % 3);
+            NodeId u = network.addNode(role);
+            mirror.names.push_back(string(network.graph().nodeName(u)));
+        } else if (op == 1 && liveNodes.size() > 2) {
+            NodeId u = liveNodes[rng() % liveNodes.size()];
+            network.removeNode(u);
+            mirror.names[u].clear();
+            for (MirrorEdge &e : mirror.edges) {
+                if (e.from == u || e.to == u) e.live = false;
+            }
+        } else if ((op == 2 || op == 3) && !liveNodes.empty()) {
+            MirrorEdge e = {liveNodes[rng() % liveNodes.size()], liveNodes[rng() % liveNodes.size()], (int)(rng() % 10),
+                            (int)(rng() % 5), true};
+            int edge = network.addEdge(e.from, e.to, e.capacity, e.cost);
+            if (network.generation != generation) mirror.compact();
+            mirror.edges.push_back(e);
+            if (edge != (int)mirror.edges.size() - 1) {
+                cout << "random trial " << trial << " failed at step " << step << ": new edge got index " << edge << "\n";
+                return false;
+            }
+        } else if (op == 4 && !liveEdges.empty()) {
+            int edge = liveEdges[rng() % liveEdges.size()];
+            network.removeEdge(edge);
+            mirror.edges[edge].live = false;
+        } else if (op == 5 && !liveEdges.empty()) {
+            int edge = liveEdges[rng() % liveEdges.size()];
+            int capacity = rng() % 12;
+            network.setCapacity(edge, capacity);
+            mirror.edges[edge].capacity = capacity;
+        } else if (op == 6) {
+            network.compact();
+            mirror.compact();
+        } else if (op == 7) {
+            if (network.maybeCompact()) mirror.compact();
+        }
+
+        liveNodes.clear();
+        for (NodeId u = 0; u < mirror.names.size(); u++) {
+            if (!mirror.names[u].empty()) liveNodes.push_back(u);
+        }
+        NodeId s = liveNodes[rng() % liveNodes.size()], t = liveNodes[rng() % liveNodes.size()];
+        string error = checkNetwork(network, mirror, s, t);
+        if (!error.empty()) {
+            cout << "random trial " << trial << " failed at step " << step << " (operation " << op << "): " << error << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    int failures = 0;
+
+    mt19937 rng(777);
+    for (int trial = 0; trial < 3000; trial++) failures += !runTrial(trial, rng);
+
+    cout << (failures == 0 ? "All dynamic network checks passed" : to_string(failures) + " checks failed") << endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,363 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include "flow_graph.hpp"
+#include "flow_result.hpp"
+#include "network_generator.hpp"
+#include "augmenting_paths.hpp"
+#include "push_relabel.hpp"
+#include "successive_shortest_path.hpp"
+#include "cost_scaling.hpp"
+#include "network_simplex.hpp"
+#include "command_line.hpp"
+
+using namespace std;
+
+// Benchmark of every solver on generated graph families.
+//
+// For each topology, size and degree a network is generated, loaded into a
+// FlowGraph once, and every selected solver is warmed up and then timed over
+// N repeats. Only the solve itself is timed; resetting the residual array
+// happens outside the clock. Results go out as CSV or JSON. The
+// augmentations column is FlowStats::augmentations: paths, pushes or pivots.
+
+struct BenchAlgorithm {
+    string name;
+    function<FlowResult(const FlowGraph&, vector<int>&, NodeId, NodeId)> run;
+};
+
+// SSP with a fixed Dijkstra queue and search mode
+BenchAlgorithm sspWith(const string& name, DijkstraQueue queue, SspSearch search = SspSearch::EarlyExit) {
+    return {name, [queue, search](const FlowGraph& g, vector<int>& r, NodeId s, NodeId t) {
+        SuccessiveShortestPath solver(g, r);
+        solver.queue = queue;
+        solver.search = search;
+        FlowResult run;
+        pair<int, int> result = solver.minCostMaxFlow(s, t);
+        run.value = result.first;
+        run.cost = result.second;
+        run.stats.augmentations = solver.augmentations;
+        run.stats.arcScans = solver.arcScans;
+        return run;
+    }};
+}
+
+vector<BenchAlgorithm> allAlgorithms() {
+    return {
+        {"ford-fulkerson", [](const FlowGraph& g, vector<int>& r, NodeId s, NodeId t) {
+            FordFulkerson solver(g, r);
+            FlowResult run;
+            run.value = solver.maxFlow(s, t);
+            run.stats.augmentations = solver.augmentations;
+            run.stats.arcScans = solver.arcScans;
+            return run;
+        }},
+        {"edmonds-karp", [](const FlowGraph& g, vector<int>& r, NodeId s, NodeId t) {
+            EdmondsKarp solver(g, r);
+            FlowResult run;
+            run.value = solver.maxFlow(s, t);
+            run.stats.augmentations = solver.augmentations;
+            run.stats.arcScans = solver.arcScans;
+            return run;
+        }},
+        {"capacity-scaling", [](const FlowGraph& g, vector<int>& r, NodeId s, NodeId t) {
+            CapacityScaling solver(g, r);
+            FlowResult run;
+            run.value = solver.maxFlow(s, t);
+            run.stats.augmentations = solver.augmentations;
+            run.stats.arcScans = solver.arcScans;
+            return run;
+        }},
+        {"dinic", [](const FlowGraph& g, vector<int>& r, NodeId s, NodeId t) {
+            Dinic solver(g, r);
+            FlowResult run;
+            run.value = solver.maxFlow(s, t);
+            run.stats.augmentations = solver.augmentations;
+            run.stats.arcScans = solver.arcScans;
+            return run;
+        }},
+        {"push-relabel", [](const FlowGraph& g, vector<int>& r, NodeId s, NodeId t) {
+            PushRelabel solver(g, r);
+            FlowResult run;
+            run.value = solver.maxFlow(s, t);
+            run.stats.augmentations = solver.pushes;
+            run.stats.arcScans = solver.arcScans;
+            return run;
+        }},
+        {"ssp", [](const FlowGraph& g, vector<int>& r, NodeId s, NodeId t) {
+            SuccessiveShortestPath solver(g, r); // r holds the flow here
+            FlowResult run;
+            pair<int, int> result = solver.minCostMaxFlow(s, t);
+            run.value = result.first;
+            run.cost = result.second;
+            run.stats.augmentations = solver.augmentations;
+            run.stats.arcScans = solver.arcScans;
+            return run;
+        }},
+        sspWith("ssp-binary-heap", DijkstraQueue::BinaryHeap),
+        sspWith("ssp-dial", DijkstraQueue::Dial),
+        sspWith("ssp-radix-heap", DijkstraQueue::RadixHeap),
+        sspWith("ssp-full-search", DijkstraQueue::Auto, SspSearch::Full),
+        sspWith("ssp-bidirectional", DijkstraQueue::Auto, SspSearch::Bidirectional),
+        {"cost-scaling", [](const FlowGraph& g, vector<int>& r, NodeId s, NodeId t) {
+            CostScalingMinCostFlow solver(g, r);
+            FlowResult run;
+            pair<int, int> result = solver.minCostMaxFlow(s, t);
+            run.value = result.first;
+            run.cost = result.second;
+            run.stats.augmentations = solver.pushes;
+            run.stats.arcScans = solver.arcScans;
+            return run;
+        }},
+        {"network-simplex", [](const FlowGraph& g, vector<int>& r, NodeId s, NodeId t) {
+            NetworkSimplex solver(g, r);
+            FlowResult run;
+            pair<int, int> result = solver.minCostMaxFlow(s, t);
+            run.value = result.first;
+            run.cost = result.second;
+            run.stats.augmentations = solver.pivots;
+            run.stats.arcScans = solver.arcScans;
+            return run;
+        }},
+    };
+}
+
+struct BenchResult {
+    string topology, algorithm;
+    int size, degree;
+    NodeId nodes;
+    int edges;
+    int repeats;
+    double medianMs, p95Ms, minMs;
+    FlowResult run;              // Last run; per-arc flow is left empty
+};
+
+struct BenchOptions {
+    vector<int> sizes{500, 2000, 8000};
+    vector<int> degrees{2, 4, 8};
+    vector<Topology> topologies{Topology::KNearest};
+    vector<string> algorithms;       // Empty runs every algorithm
+    int repeats = 5, warmup = 1;
+    uint64_t seed = 1;
+    bool json = false;
+    string output;                   // Empty writes to stdout
+};
+
+const char* topologyName(Topology topology) {
+    if (topology == Topology::FullMesh) return "full";
+    if (topology == Topology::Grid) return "grid";
+    return "knearest";
+}
+
+bool parseTopologyName(const string& name, Topology& topology) {
+    if (name == "full") topology = Topology::FullMesh;
+    else if (name == "knearest") topology = Topology::KNearest;
+    else if (name == "grid") topology = Topology::Grid;
+    else return false;
+    return true;
+}
+
+vector<string> splitList(const string& text) {
+    vector<string> items;
+    stringstream stream(text);
+    string item;
+    while (getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+// Nearest-rank percentile of sorted samples
+double percentile(const vector<double>& sorted, double p) {
+    size_t rank = (size_t)ceil(p * sorted.size());
+    return sorted[min(sorted.size() - 1, rank == 0 ? 0 : rank - 1)];
+}
+
+// Warm up, then time repeats solves; only the solve is inside the clock
+BenchResult measure(const BenchAlgorithm& algorithm, const FlowGraph& graph, NodeId source, NodeId sink,
+                    const BenchOptions& options) {
+    vector<int> residual;
+    vector<double> samples;
+    BenchResult result;
+
+    for (int i = 0; i < options.warmup + options.repeats; i++) {
+        residual.assign(graph.capacity.begin(), graph.capacity.end());
+        auto start = chrono::steady_clock::now();
+        result.run = algorithm.run(graph, residual, source, sink);
+        auto end = chrono::steady_clock::now();
+        if (i >= options.warmup) samples.push_back(chrono::duration<double, milli>(end - start).count());
+    }
+
+    sort(samples.begin(), samples.end());
+    result.algorithm = algorithm.name;
+    result.repeats = options.repeats;
+    result.medianMs = samples.size() % 2 ? samples[samples.size() / 2]
+                                         : (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]) / 2;
+    result.p95Ms = percentile(samples, 0.95);
+    result.minMs = samples.front();
+    return result;
+}
+
+void writeCsv(ostream& out, const vector<BenchResult>& results) {
+    out << "topology,size,degree,nodes,edges,algorithm,repeats,flow,cost,median_ms,p95_ms,min_ms,augmentations,arc_scans\n";
+    for (const BenchResult& r : results) {
+        out << r.topology << ',' << r.size << ',' << r.degree << ',' << r.nodes << ',' << r.edges << ','
+            << r.algorithm << ',' << r.repeats << ',' << r.run.value << ',';
+        if (r.run.cost >= 0) out << r.run.cost;
+        out << ',' << r.medianMs << ',' << r.p95Ms << ',' << r.minMs << ','
+            << r.run.stats.augmentations << ',' << r.run.stats.arcScans << '\n';
+    }
+}
+
+void writeJson(ostream& out, const vector<BenchResult>& results) {
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        out << "    {\"topology\": \"" << r.topology << "\", \"size\": " << r.size << ", \"degree\": " << r.degree
+            << ", \"nodes\": " << r.nodes << ", \"edges\": " << r.edges << ", \"algorithm\": \"" << r.algorithm
+            << "\", \"repeats\": " << r.repeats << ", \"flow\": " << r.run.value << ", \"cost\": ";
+        if (r.run.cost >= 0) out << r.run.cost;
+        else out << "null";
+        out << ", \"median_ms\": " << r.medianMs << ", \"p95_ms\": " << r.p95Ms << ", \"min_ms\": " << r.minMs
+            << ", \"augmentations\": " << r.run.stats.augmentations << ", \"arc_scans\": " << r.run.stats.arcScans << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        size_t eq = arg.find('=');
+        string key = arg.substr(0, eq), value = eq == string::npos ? "" : arg.substr(eq + 1);
+        if (key == "--sizes" || key == "--degrees") {
+            vector<int>& list = key == "--sizes" ? options.sizes : options.degrees;
+            list.clear();
+            for (const string& item : splitList(value)) {
+                long long number = 0;
+                if (!parseInteger(item, number, 1, numeric_limits<int>::max())) {
+                    cerr << "Error: Invalid value for " << key << ": " << item << " (expected a positive integer)" << endl;
+                    return 1;
+                }
+                list.push_back((int)number);
+            }
+            if (list.empty()) {
+                cerr << "Error: " << key << " needs at least one value" << endl;
+                return 1;
+            }
+        } else if (key == "--topologies") {
+            options.topologies.clear();
+            for (const string& item : splitList(value)) {
+                Topology topology;
+                if (!parseTopologyName(item, topology)) {
+                    cerr << "Error: Unknown topology " << item << " (expected full, knearest or grid)" << endl;
+                    return 1;
+                }
+                options.topologies.push_back(topology);
+            }
+        } else if (key == "--algorithms") {
+            options.algorithms = splitList(value);
+        } else if (key == "--repeats" || key == "--warmup") {
+            long long count = 0;
+            long long low = key == "--repeats" ? 1 : 0;
+            if (!parseInteger(value, count, low, numeric_limits<int>::max())) {
+                cerr << "Error: Invalid value for " << key << ": " << value << " (expected an integer of at least " << low << ")" << endl;
+                return 1;
+            }
+            (key == "--repeats" ? options.repeats : options.warmup) = (int)count;
+        } else if (key == "--seed") {
+            unsigned long long seed = 0;
+            if (!parseUnsigned(value, seed)) {
+                cerr << "Error: Invalid value for --seed: " << value << endl;
+                return 1;
+            }
+            options.seed = seed;
+        } else if (key == "--format") {
+            if (value != "csv" && value != "json") {
+                cerr << "Error: Unknown format " << value << " (expected csv or json)" << endl;
+                return 1;
+            }
+            options.json = value == "json";
+        } else if (key == "--output") {
+            options.output = value;
+        } else {
+            cerr << "Error: Unknown option " << arg << endl;
+            return 1;
+        }
+    }
+
+    vector<BenchAlgorithm> algorithms;
+    for (const BenchAlgorithm& algorithm : allAlgorithms()) {
+        if (options.algorithms.empty() ||
+            find(options.algorithms.begin(), options.algorithms.end(), algorithm.name) != options.algorithms.end()) {
+            algorithms.push_back(algorithm);
+        }
+    }
+    if (algorithms.empty()) {
+        cerr << "Error: No known algorithm selected" << endl;
+        return 1;
+    }
+
+    vector<BenchResult> results;
+    for (Topology topology : options.topologies) {
+        for (int size : options.sizes) {
+            // The full mesh has no degree knob, so it is generated once per size
+            vector<int> degrees = topology == Topology::FullMesh ? vector<int>{0} : options.degrees;
+            for (int degree : degrees) {
+                GeneratorOptions generatorOptions;
+                generatorOptions.numDrones = size;
+                generatorOptions.numWarehouses = max(1, size / 20);
+                generatorOptions.numDestinations = max(1, size / 2);
+                generatorOptions.topology = topology;
+                generatorOptions.neighbours = max(1, degree);
+                generatorOptions.seed = options.seed;
+
+                FlowGraphSink sink;
+                ParallelNetworkGenerator(generatorOptions).generate(sink);
+                FlowGraph graph = sink.build();
+
+                cerr << topologyName(topology) << " size " << size << " degree " << degree << ": "
+                     << graph.numNodes << " nodes, " << graph.numEdges() << " edges" << endl;
+
+                long long referenceFlow = -1;
+                for (const BenchAlgorithm& algorithm : algorithms) {
+                    BenchResult result = measure(algorithm, graph, NetworkLayout::SOURCE, NetworkLayout::SINK, options);
+                    result.topology = topologyName(topology);
+                    result.size = size;
+                    result.degree = degree;
+                    result.nodes = graph.numNodes;
+                    result.edges = graph.numEdges();
+                    if (referenceFlow == -1) referenceFlow = result.run.value;
+                    else if (result.run.value != referenceFlow) {
+                        cerr << "Warning: " << algorithm.name << " found flow " << result.run.value
+                             << ", expected " << referenceFlow << endl;
+                    }
+                    cerr << "  " << algorithm.name << ": " << result.medianMs << " ms median" << endl;
+                    results.push_back(result);
+                }
+            }
+        }
+    }
+
+    if (options.output.empty()) {
+        if (options.json) writeJson(cout, results);
+        else writeCsv(cout, results);
+        return 0;
+    }
+    ofstream file(options.output);
+    if (!file) {
+        cerr << "Error: Unable to write " << options.output << endl;
+        return 1;
+    }
+    if (options.json) writeJson(file, results);
+    else writeCsv(file, results);
+    return 0;
+}
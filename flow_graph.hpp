@@ -0,0 +1,659 @@
+#ifndef FLOW_GRAPH_HPP
+#define FLOW_GRAPH_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "json.hpp"
+#include "mapped_file.hpp"
+#include "node_interner.hpp"
+
+// Read-only array that either owns its elements or views memory owned by
+// someone else (a MappedFile). Copies of a view share the same memory.
+template <typename T>
+class GraphArray {
+private:
+    std::vector<T> storage;
+    const T *ptr = nullptr;
+    size_t len = 0;
+
+public:
+    GraphArray() {}
+    GraphArray(std::vector<T> values) : storage(std::move(values)), ptr(storage.data()), len(storage.size()) {}
+    GraphArray(const GraphArray &other) { *this = other; }
+    GraphArray(GraphArray &&other) noexcept { *this = std::move(other); }
+
+    GraphArray &operator=(const GraphArray &other) {
+        if (this == &other) return *this;
+        if (other.owning()) {
+            storage = other.storage;
+            ptr = storage.data();
+        } else {
+            storage.clear();
+            ptr = other.ptr;
+        }
+        len = other.len;
+        return *this;
+    }
+
+    GraphArray &operator=(GraphArray &&other) noexcept {
+        if (this == &other) return *this;
+        bool owned = other.owning();
+        storage = std::move(other.storage);
+        ptr = owned ? storage.data() : other.ptr;
+        len = other.len;
+        other.ptr = nullptr;
+        other.len = 0;
+        return *this;
+    }
+
+    static GraphArray view(const T *data, size_t size) {
+        GraphArray result;
+        result.ptr = data;
+        result.len = size;
+        return result;
+    }
+
+    bool owning() const { return !storage.empty() && ptr == storage.data(); }
+
+    const T &operator[](size_t i) const { return ptr[i]; }
+    const T *data() const { return ptr; }
+    size_t size() const { return len; }
+    const T *begin() const { return ptr; }
+    const T *end() const { return ptr + len; }
+};
+
+// Compressed sparse row (CSR) flow network shared by all solvers.
+//
+// Every input edge u -> v is stored as a pair of arcs: a forward arc in u's
+// range carrying the capacity and cost, and a reverse arc in v's range with
+// capacity 0 and negated cost. reverse[a] gives the partner of arc a, so a
+// solver only needs one flat array indexed by arc to hold its residual state.
+//
+// The graph is immutable once built. Its arrays either own their memory
+// (built from JSON) or point straight into a memory-mapped binary file.
+struct FlowGraph {
+    NodeId numNodes = 0;
+    GraphArray<int> offset;     // Arcs of node u are [offset[u], offset[u + 1])
+    GraphArray<NodeId> head;    // Target node of each arc
+    GraphArray<int> capacity;   // Capacity of each arc (0 on reverse arcs)
+    GraphArray<int> cost;       // Cost of each arc (negated on reverse arcs)
+    GraphArray<int> reverse;    // Index of the paired reverse arc
+    GraphArray<int> inputArc;   // Forward arc of each input edge, in input order
+
+    // Node names: name of u is nameData[nameOffset[u], nameOffset[u + 1]).
+    // nameOrder lists node ids sorted by name for lookups.
+    GraphArray<uint32_t> nameOffset;
+    GraphArray<char> nameData;
+    GraphArray<NodeId> nameOrder;
+
+    std::shared_ptr<MappedFile> mapping; // Backing file of a mapped graph
+
+    int numArcs() const { return (int)head.size(); }
+    int numEdges() const { return (int)inputArc.size(); }
+    NodeId tail(int arc) const { return head[reverse[arc]]; }
+
+    std::string_view nodeName(NodeId node) const {
+        return std::string_view(nameData.data() + nameOffset[node], nameOffset[node + 1] - nameOffset[node]);
+    }
+
+    // Binary search over nameOrder, INVALID_NODE if the name is unknown
+    NodeId nodeId(std::string_view name) const {
+        auto it = std::lower_bound(nameOrder.begin(), nameOrder.end(), name,
+                                   [this](NodeId node, std::string_view key) { return nodeName(node) < key; });
+        if (it == nameOrder.end() || nodeName(*it) != name) return INVALID_NODE;
+        return *it;
+    }
+
+    // Largest capacity on any arc, used by the scaling solvers
+    int maxCapacity() const {
+        int result = 0;
+        for (int c : capacity) result = std::max(result, c);
+        return result;
+    }
+};
+
+// Collects edges in input order and lays them out as a FlowGraph.
+// Node names are interned the first time they are seen.
+class FlowGraphBuilder {
+private:
+    struct InputEdge {
+        NodeId from, to;
+        int capacity, cost;
+    };
+
+    NodeInterner names;
+    std::vector<InputEdge> edges;
+
+public:
+    NodeId addNode(std::string_view name) { return names.intern(name); }
+
+    void addEdge(NodeId from, NodeId to, int capacity, int cost = 1) {
+        edges.push_back({from, to, capacity, cost});
+    }
+
+    void addEdge(std::string_view from, std::string_view to, int capacity, int cost = 1) {
+        NodeId u = addNode(from);
+        NodeId v = addNode(to);
+        addEdge(u, v, capacity, cost);
+    }
+
+    NodeId numNodes() const { return (NodeId)names.size(); }
+    std::string_view nodeName(NodeId node) const { return names.name(node); }
+
+    // Counting sort of both arc directions by tail node
+    FlowGraph build() {
+        FlowGraph graph;
+        NodeId n = numNodes();
+        int m = (int)edges.size();
+
+        std::vector<int> offset(n + 1, 0), capacity(2 * m), cost(2 * m), reverse(2 * m), inputArc(m);
+        std::vector<NodeId> head(2 * m);
+
+        for (const auto &e : edges) {
+            offset[e.from + 1]++;
+            offset[e.to + 1]++;
+        }
+        for (NodeId u = 0; u < n; u++) offset[u + 1] += offset[u];
+
+        std::vector<int> next(offset.begin(), offset.end() - 1);
+        for (int i = 0; i < m; i++) {
+            const auto &e = edges[i];
+            int a = next[e.from]++;
+            int b = next[e.to]++;
+
+            head[a] = e.to;
+            capacity[a] = e.capacity;
+            cost[a] = e.cost;
+            reverse[a] = b;
+
+            head[b] = e.from;
+            capacity[b] = 0;
+            cost[b] = -e.cost;
+            reverse[b] = a;
+
+            inputArc[i] = a;
+        }
+        std::vector<InputEdge>().swap(edges);
+
+        std::vector<NodeId> nameOrder(n);
+        for (NodeId u = 0; u < n; u++) nameOrder[u] = u;
+        std::sort(nameOrder.begin(), nameOrder.end(),
+                  [this](NodeId a, NodeId b) { return names.name(a) < names.name(b); });
+
+        std::vector<uint32_t> nameOffset;
+        std::vector<char> nameData;
+        names.release(nameData, nameOffset);
+
+        graph.numNodes = n;
+        graph.offset = std::move(offset);
+        graph.head = std::move(head);
+        graph.capacity = std::move(capacity);
+        graph.cost = std::move(cost);
+        graph.reverse = std::move(reverse);
+        graph.inputArc = std::move(inputArc);
+        graph.nameOffset = std::move(nameOffset);
+        graph.nameData = std::move(nameData);
+        graph.nameOrder = std::move(nameOrder);
+        return graph;
+    }
+};
+
+// Binary network format (version 1), native little-endian:
+//
+//   FlowGraphFileHeader
+//   offset[n + 1] head[2m] capacity[2m] cost[2m] reverse[2m] inputArc[m]
+//   nameOffset[n + 1] nameOrder[n] nameData[nameBytes]
+//
+// Every section starts on an 8-byte boundary at the position recorded in the
+// header, so a mapped file can be viewed in place without copying.
+const char FLOW_GRAPH_MAGIC[8] = {'D', 'D', 'N', 'F', 'L', 'O', 'W', '\0'};
+const uint32_t FLOW_GRAPH_VERSION = 1;
+const uint32_t FLOW_GRAPH_BYTE_ORDER = 0x01020304;
+
+enum FlowGraphSection {
+    SECTION_OFFSET, SECTION_HEAD, SECTION_CAPACITY, SECTION_COST, SECTION_REVERSE,
+    SECTION_INPUT_ARC, SECTION_NAME_OFFSET, SECTION_NAME_ORDER, SECTION_NAME_DATA,
+    SECTION_COUNT
+};
+
+struct FlowGraphFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t numNodes;
+    uint32_t numEdges;
+    uint64_t nameBytes;
+    uint64_t sectionOffset[SECTION_COUNT];
+    uint64_t sectionBytes[SECTION_COUNT];
+};
+
+inline bool isBinaryFlowGraph(const std::string &filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(FLOW_GRAPH_MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    return file && std::memcmp(magic, FLOW_GRAPH_MAGIC, sizeof(magic)) == 0;
+}
+
+// Fill in the header for a graph of the given shape and return the file size
+inline uint64_t layoutFlowGraphFile(FlowGraphFileHeader &header, uint64_t numNodes, uint64_t numEdges, uint64_t nameBytes) {
+    header = {};
+    std::memcpy(header.magic, FLOW_GRAPH_MAGIC, sizeof(header.magic));
+    header.version = FLOW_GRAPH_VERSION;
+    header.byteOrder = FLOW_GRAPH_BYTE_ORDER;
+    header.numNodes = (uint32_t)numNodes;
+    header.numEdges = (uint32_t)numEdges;
+    header.nameBytes = nameBytes;
+
+    uint64_t n = numNodes, m = numEdges;
+    uint64_t sizes[SECTION_COUNT] = {
+        (n + 1) * sizeof(int), 2 * m * sizeof(NodeId), 2 * m * sizeof(int), 2 * m * sizeof(int),
+        2 * m * sizeof(int), m * sizeof(int), (n + 1) * sizeof(uint32_t), n * sizeof(NodeId), nameBytes,
+    };
+    uint64_t position = (sizeof(header) + 7) & ~uint64_t(7);
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        header.sectionOffset[i] = position;
+        header.sectionBytes[i] = sizes[i];
+        position = (position + sizes[i] + 7) & ~uint64_t(7);
+    }
+    return position;
+}
+
+inline bool saveFlowGraphBinary(const std::string &filename, const FlowGraph &graph) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) return false;
+
+    FlowGraphFileHeader header;
+    uint64_t fileSize = layoutFlowGraphFile(header, graph.numNodes, graph.numEdges(), graph.nameData.size());
+
+    const void *sections[SECTION_COUNT] = {
+        graph.offset.data(), graph.head.data(), graph.capacity.data(), graph.cost.data(),
+        graph.reverse.data(), graph.inputArc.data(), graph.nameOffset.data(), graph.nameOrder.data(),
+        graph.nameData.data(),
+    };
+
+    const char padding[8] = {};
+    file.write((const char *)&header, sizeof(header));
+    uint64_t written = sizeof(header);
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        file.write(padding, header.sectionOffset[i] - written);
+        file.write((const char *)sections[i], header.sectionBytes[i]);
+        written = header.sectionOffset[i] + header.sectionBytes[i];
+    }
+    file.write(padding, fileSize - written);
+    return (bool)file;
+}
+
+// Writes a binary network straight into a mapped output file, for graphs
+// too large to build in memory. The caller first counts the arcs of every
+// node (out-edges plus in-edges) and the total name length, then adds the
+// edges in input order and the names in id order. The arcs end up exactly
+// where FlowGraphBuilder would put them. The only memory used, apart from
+// the file's pages, is one cursor per node.
+class FlowGraphFileWriter {
+private:
+    MappedFile file;
+    FlowGraphFileHeader header;
+    NodeId numNodes = 0;
+    std::vector<int> next;          // Next free arc of each node
+    int edgesAdded = 0;
+    NodeId namesAdded = 0;
+    uint64_t nameBytesAdded = 0;
+
+    template <typename T>
+    T *section(int index) { return (T *)(file.writableData() + header.sectionOffset[index]); }
+
+public:
+    bool create(const std::string &filename, const std::vector<int> &arcsPerNode, uint64_t numEdges, uint64_t nameBytes) {
+        numNodes = (NodeId)arcsPerNode.size();
+        uint64_t fileSize = layoutFlowGraphFile(header, numNodes, numEdges, nameBytes);
+        if (!file.create(filename, fileSize)) return false;
+        std::memcpy(file.writableData(), &header, sizeof(header));
+
+        int *offset = section<int>(SECTION_OFFSET);
+        next.resize(numNodes);
+        offset[0] = 0;
+        for (NodeId u = 0; u < numNodes; u++) {
+            next[u] = offset[u];
+            offset[u + 1] = offset[u] + arcsPerNode[u];
+        }
+        section<uint32_t>(SECTION_NAME_OFFSET)[0] = 0;
+        edgesAdded = 0;
+        namesAdded = 0;
+        nameBytesAdded = 0;
+        return true;
+    }
+
+    void addEdge(NodeId from, NodeId to, int capacity, int cost) {
+        int a = next[from]++;
+        int b = next[to]++;
+        section<NodeId>(SECTION_HEAD)[a] = to;
+        section<int>(SECTION_CAPACITY)[a] = capacity;
+        section<int>(SECTION_COST)[a] = cost;
+        section<int>(SECTION_REVERSE)[a] = b;
+        section<NodeId>(SECTION_HEAD)[b] = from;
+        section<int>(SECTION_CAPACITY)[b] = 0;
+        section<int>(SECTION_COST)[b] = -cost;
+        section<int>(SECTION_REVERSE)[b] = a;
+        section<int>(SECTION_INPUT_ARC)[edgesAdded++] = a;
+    }
+
+    void addName(std::string_view name) {
+        std::memcpy(section<char>(SECTION_NAME_DATA) + nameBytesAdded, name.data(), name.size());
+        nameBytesAdded += name.size();
+        section<uint32_t>(SECTION_NAME_OFFSET)[++namesAdded] = (uint32_t)nameBytesAdded;
+    }
+
+    // Sort the name index and flush the file; false if the counts announced
+    // to create() were not met
+    bool finish() {
+        bool complete = edgesAdded == (int)header.numEdges && namesAdded == numNodes && nameBytesAdded == header.nameBytes;
+        for (NodeId u = 0; complete && u < numNodes; u++) {
+            complete = next[u] == section<int>(SECTION_OFFSET)[u + 1];
+        }
+        if (complete) {
+            const uint32_t *nameOffset = section<uint32_t>(SECTION_NAME_OFFSET);
+            const char *nameData = section<char>(SECTION_NAME_DATA);
+            auto name = [&](NodeId u) { return std::string_view(nameData + nameOffset[u], nameOffset[u + 1] - nameOffset[u]); };
+            NodeId *nameOrder = section<NodeId>(SECTION_NAME_ORDER);
+            for (NodeId u = 0; u < numNodes; u++) nameOrder[u] = u;
+            std::sort(nameOrder, nameOrder + numNodes, [&](NodeId a, NodeId b) { return name(a) < name(b); });
+        }
+        std::vector<int>().swap(next);
+        file.close();
+        return complete;
+    }
+};
+
+// Checks that the arrays describe a well-formed graph, so solvers can index
+// them without bounds checks: offsets rising from 0 to numArcs, heads and
+// arc ids in range, reverse arcs paired and pointing back at their tail,
+// and name offsets inside the name data. One pass over every array.
+inline bool validateFlowGraph(const FlowGraph &graph, std::string &problem) {
+    NodeId n = graph.numNodes;
+    size_t arcs = graph.head.size(), nameBytes = graph.nameData.size();
+    if (graph.offset.size() != (size_t)n + 1 || graph.offset[0] != 0 || (size_t)graph.offset[n] != arcs) {
+        problem = "arc offsets do not span the arcs";
+        return false;
+    }
+    for (NodeId u = 0; u < n; u++) {
+        if (graph.offset[u] > graph.offset[u + 1]) {
+            problem = "arc offsets decrease at node " + std::to_string(u);
+            return false;
+        }
+        for (int a = graph.offset[u]; a < graph.offset[u + 1]; a++) {
+            int r = graph.reverse[a];
+            if (graph.head[a] >= n || r < 0 || (size_t)r >= arcs || graph.reverse[r] != a || graph.head[r] != u) {
+                problem = "arc " + std::to_string(a) + " has a bad head or reverse arc";
+                return false;
+            }
+        }
+    }
+    for (int a : graph.inputArc) {
+        if (a < 0 || (size_t)a >= arcs) {
+            problem = "input edge arc " + std::to_string(a) + " is out of range";
+            return false;
+        }
+    }
+    if (graph.nameOffset.size() != (size_t)n + 1 || graph.nameOffset[0] != 0 || graph.nameOffset[n] != nameBytes) {
+        problem = "name offsets do not span the name data";
+        return false;
+    }
+    for (NodeId u = 0; u < n; u++) {
+        if (graph.nameOffset[u] > graph.nameOffset[u + 1]) {
+            problem = "name offsets decrease at node " + std::to_string(u);
+            return false;
+        }
+    }
+    // Shorter than the node count when nodes were removed (DynamicFlowNetwork)
+    if (graph.nameOrder.size() > (size_t)n) {
+        problem = "name index has more entries than nodes";
+        return false;
+    }
+    for (size_t i = 0; i < graph.nameOrder.size(); i++) {
+        if (graph.nameOrder[i] >= n) {
+            problem = "name index is corrupt at entry " + std::to_string(i);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Map a binary network file and point the graph's arrays into it
+inline bool mapFlowGraphBinary(const std::string &filename, FlowGraph &graph) {
+    auto mapping = std::make_shared<MappedFile>();
+    if (!mapping->open(filename) || mapping->size() < sizeof(FlowGraphFileHeader)) return false;
+
+    FlowGraphFileHeader header;
+    std::memcpy(&header, mapping->data(), sizeof(header));
+    if (std::memcmp(header.magic, FLOW_GRAPH_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != FLOW_GRAPH_VERSION || header.byteOrder != FLOW_GRAPH_BYTE_ORDER) {
+        return false;
+    }
+
+    uint64_t n = header.numNodes, m = header.numEdges;
+    if (n >= INVALID_NODE || 2 * m > (uint64_t)std::numeric_limits<int>::max()) return false;
+    uint64_t expected[SECTION_COUNT] = {
+        (n + 1) * sizeof(int), 2 * m * sizeof(NodeId), 2 * m * sizeof(int), 2 * m * sizeof(int),
+        2 * m * sizeof(int), m * sizeof(int), (n + 1) * sizeof(uint32_t), n * sizeof(NodeId), header.nameBytes,
+    };
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        if (header.sectionBytes[i] != expected[i] || header.sectionOffset[i] % 8 != 0 ||
+            header.sectionOffset[i] + header.sectionBytes[i] > mapping->size()) {
+            return false;
+        }
+    }
+
+    const char *base = mapping->data();
+    auto ints = [&](int section, size_t count) {
+        return GraphArray<int>::view((const int *)(base + header.sectionOffset[section]), count);
+    };
+    auto ids = [&](int section, size_t count) {
+        return GraphArray<uint32_t>::view((const uint32_t *)(base + header.sectionOffset[section]), count);
+    };
+
+    graph = FlowGraph();
+    graph.numNodes = (NodeId)n;
+    graph.offset = ints(SECTION_OFFSET, n + 1);
+    graph.head = ids(SECTION_HEAD, 2 * m);
+    graph.capacity = ints(SECTION_CAPACITY, 2 * m);
+    graph.cost = ints(SECTION_COST, 2 * m);
+    graph.reverse = ints(SECTION_REVERSE, 2 * m);
+    graph.inputArc = ints(SECTION_INPUT_ARC, m);
+    graph.nameOffset = ids(SECTION_NAME_OFFSET, n + 1);
+    graph.nameOrder = ids(SECTION_NAME_ORDER, n);
+    graph.nameData = GraphArray<char>::view(base + header.sectionOffset[SECTION_NAME_DATA], header.nameBytes);
+    graph.mapping = mapping;
+
+    std::string problem;
+    if (!validateFlowGraph(graph, problem)) {
+        std::cerr << "Error: " << filename << " is corrupt: " << problem << std::endl;
+        graph = FlowGraph();
+        return false;
+    }
+    return true;
+}
+
+// Edge cost model for network.json. An explicit "cost" always wins; without
+// it the cost is the edge's energy use in Wh, taken from "energy_wh" or
+// estimated from "distance_km". Edges with none of the three cost one unit
+// per hop.
+const int DEFAULT_EDGE_COST = 1;
+const double DRONE_ENERGY_WH_PER_KM = 25.0;
+
+// SAX handler for network.json ({"node": [{"destination": ..., "capacity": ...}]}).
+// Each edge object is handed to the builder as soon as it closes, so the
+// document is never materialized.
+class NetworkJsonHandler : public nlohmann::json_sax<nlohmann::json> {
+private:
+    FlowGraphBuilder &builder;
+    const std::string &filename;
+    int depth = 0;        // 1 inside the root object, 2 in an edge list, 3 in an edge
+    NodeId from = INVALID_NODE, to = INVALID_NODE;
+    std::string currentKey;
+    long long capacity = 0, cost = 0;
+    double distanceKm = 0, energyWh = 0;
+    bool hasDestination = false, hasCapacity = false, hasCost = false, hasDistance = false, hasEnergy = false;
+
+    bool value(long long number) {
+        if (depth != 3) return true;
+        if (currentKey == "capacity") {
+            capacity = number;
+            hasCapacity = true;
+        } else if (currentKey == "cost") {
+            cost = number;
+            hasCost = true;
+        } else {
+            return value((double)number);
+        }
+        return true;
+    }
+
+    bool value(double number) {
+        if (depth != 3) return true;
+        if (currentKey == "distance_km") {
+            distanceKm = number;
+            hasDistance = true;
+        } else if (currentKey == "energy_wh") {
+            energyWh = number;
+            hasEnergy = true;
+        } else if (currentKey == "capacity" || currentKey == "cost") {
+            return value(roundToLongLong(number));
+        }
+        return true;
+    }
+
+    // Rounds, saturating instead of overflowing, so the range checks in
+    // end_object() see values too large for an int
+    static long long roundToLongLong(double number) {
+        if (number >= 9e18) return std::numeric_limits<long long>::max();
+        if (number <= -9e18) return std::numeric_limits<long long>::min();
+        return std::llround(number);
+    }
+
+    long long edgeCost() const {
+        if (hasCost) return cost;
+        if (hasEnergy) return roundToLongLong(energyWh);
+        if (hasDistance) return roundToLongLong(distanceKm * DRONE_ENERGY_WH_PER_KM);
+        return DEFAULT_EDGE_COST;
+    }
+
+    // Edges are keyed by their source node, so anything but an object at
+    // the top level leaves them without one
+    bool rootNotObject() const {
+        std::cerr << "Error: " << filename << ": the top-level value must be an object of node names" << std::endl;
+        return false;
+    }
+
+public:
+    NetworkJsonHandler(FlowGraphBuilder &b, const std::string &name) : builder(b), filename(name) {}
+
+    bool null() override { return depth > 0 || rootNotObject(); }
+    bool boolean(bool) override { return depth > 0 || rootNotObject(); }
+    bool number_integer(number_integer_t number) override { return depth > 0 ? value((long long)number) : rootNotObject(); }
+    bool number_unsigned(number_unsigned_t number) override {
+        if (depth == 0) return rootNotObject();
+        return value((long long)std::min<number_unsigned_t>(number, std::numeric_limits<long long>::max()));
+    }
+    bool number_float(number_float_t number, const string_t &) override { return depth > 0 ? value((double)number) : rootNotObject(); }
+    bool binary(binary_t &) override { return depth > 0 || rootNotObject(); }
+
+    bool string(string_t &text) override {
+        if (depth == 0) return rootNotObject();
+        if (depth == 3 && currentKey == "destination") {
+            to = builder.addNode(text);
+            hasDestination = true;
+        }
+        return true;
+    }
+
+    bool key(string_t &text) override {
+        if (depth == 1) from = builder.addNode(text);
+        else currentKey = std::move(text);
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        depth++;
+        if (depth == 3) {
+            capacity = cost = 0;
+            distanceKm = energyWh = 0;
+            hasDestination = hasCapacity = hasCost = hasDistance = hasEnergy = false;
+        }
+        return true;
+    }
+
+    bool end_object() override {
+        if (depth == 3) {
+            if (from == INVALID_NODE) return rootNotObject();
+            if (!hasDestination || !hasCapacity) {
+                std::cerr << "Error: " << filename << ": edge of " << builder.nodeName(from)
+                          << " is missing destination or capacity" << std::endl;
+                return false;
+            }
+            long long edgeCostValue = edgeCost();
+            if (capacity < 0 || capacity > std::numeric_limits<int>::max()) {
+                std::cerr << "Error: " << filename << ": edge " << builder.nodeName(from) << " -> " << builder.nodeName(to)
+                          << " has capacity " << capacity << ", outside 0.." << std::numeric_limits<int>::max() << std::endl;
+                return false;
+            }
+            // Negative costs would break the non-negative reduced costs the
+            // SSP Dijkstra relies on, so energy and distance must not be negative either
+            if (edgeCostValue < 0 || edgeCostValue > std::numeric_limits<int>::max() || (hasEnergy && energyWh < 0) ||
+                (hasDistance && distanceKm < 0)) {
+                std::cerr << "Error: " << filename << ": edge " << builder.nodeName(from) << " -> " << builder.nodeName(to)
+                          << " has a negative or too large cost, energy_wh or distance_km" << std::endl;
+                return false;
+            }
+            builder.addEdge(from, to, (int)capacity, (int)edgeCostValue);
+        }
+        depth--;
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        if (depth == 0) return rootNotObject();
+        depth++;
+        return true;
+    }
+
+    bool end_array() override {
+        depth--;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &ex) override {
+        std::cerr << "Error: " << filename << ": " << ex.what() << std::endl;
+        return false;
+    }
+};
+
+// Stream a network.json file into a FlowGraph
+inline bool loadFlowGraphJSON(const std::string &filename, FlowGraph &graph) {
+    std::ifstream file(filename);
+    if (!file) return false;
+
+    FlowGraphBuilder builder;
+    NetworkJsonHandler handler(builder, filename);
+    if (!nlohmann::json::sax_parse(file, &handler)) return false;
+
+    graph = builder.build();
+    return true;
+}
+
+// Load either network format: binary files are memory-mapped, anything else
+// is parsed as JSON. Returns false if the file cannot be read.
+inline bool loadFlowGraph(const std::string &filename, FlowGraph &graph) {
+    if (isBinaryFlowGraph(filename)) return mapFlowGraphBinary(filename, graph);
+    return loadFlowGraphJSON(filename, graph);
+}
+
+#endif // FLOW_GRAPH_HPP
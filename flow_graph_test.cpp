@@ -0,0 +1,89 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "flow_graph.hpp"
+
+using namespace std;
+
+// Loader tests for network.json: well-formed files load, and malformed or
+// out-of-range ones fail the load instead of producing a wrong graph. Each
+// case writes a small file next to the binary and removes it afterwards.
+
+const char *const TEST_FILE = "flow_graph_test.json";
+
+bool loadText(const string &text, FlowGraph &graph) {
+    {
+        ofstream out(TEST_FILE);
+        out << text;
+    }
+    bool loaded = loadFlowGraphJSON(TEST_FILE, graph);
+    remove(TEST_FILE);
+    return loaded;
+}
+
+bool expectRejected(const string &name, const string &text) {
+    FlowGraph graph;
+    if (!loadText(text, graph)) return true;
+    cout << name << " failed: the file loaded\n";
+    return false;
+}
+
+// The single edge A -> B must come back with this capacity and cost
+bool expectEdge(const string &name, const string &text, int capacity, int cost) {
+    FlowGraph graph;
+    if (!loadText(text, graph)) {
+        cout << name << " failed: the file did not load\n";
+        return false;
+    }
+    string problem;
+    if (!validateFlowGraph(graph, problem)) {
+        cout << name << " failed: " << problem << "\n";
+        return false;
+    }
+    NodeId a = graph.nodeId("A"), b = graph.nodeId("B");
+    if (graph.numEdges() != 1 || a == INVALID_NODE || b == INVALID_NODE) {
+        cout << name << " failed: expected one edge A -> B\n";
+        return false;
+    }
+    int arc = graph.inputArc[0];
+    if (graph.tail(arc) != a || graph.head[arc] != b || graph.capacity[arc] != capacity || graph.cost[arc] != cost) {
+        cout << name << " failed: edge is " << graph.capacity[arc] << " / " << graph.cost[arc] << "\n";
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    int failures = 0;
+    cerr.setstate(ios::failbit); // The rejected cases report on cerr by design
+
+    failures += !expectEdge("explicit cost", R"({"A": [{"destination": "B", "capacity": 7, "cost": 3}]})", 7, 3);
+    failures += !expectEdge("energy cost", R"({"A": [{"destination": "B", "capacity": 7, "energy_wh": 12.4}]})", 7, 12);
+    failures += !expectEdge("distance cost", R"({"A": [{"destination": "B", "capacity": 7, "distance_km": 2}]})", 7, 50);
+    failures += !expectEdge("default cost", R"({"A": [{"destination": "B", "capacity": 7}]})", 7, DEFAULT_EDGE_COST);
+    failures += !expectEdge("largest capacity", R"({"A": [{"destination": "B", "capacity": 2147483647}]})", 2147483647, 1);
+
+    failures += !expectRejected("root array", R"([[{"destination": "A", "capacity": 1}]])");
+    failures += !expectRejected("root number", "5");
+    failures += !expectRejected("root string", R"("network")");
+    failures += !expectRejected("missing capacity", R"({"A": [{"destination": "B"}]})");
+    failures += !expectRejected("negative capacity", R"({"A": [{"destination": "B", "capacity": -1}]})");
+    failures += !expectRejected("capacity above int", R"({"A": [{"destination": "B", "capacity": 3000000000}]})");
+    failures += !expectRejected("huge unsigned capacity", R"({"A": [{"destination": "B", "capacity": 18446744073709551615}]})");
+    failures += !expectRejected("cost above int", R"({"A": [{"destination": "B", "capacity": 1, "cost": 3000000000}]})");
+    failures += !expectRejected("huge energy", R"({"A": [{"destination": "B", "capacity": 1, "energy_wh": 1e30}]})");
+    failures += !expectEdge("zero cost", R"({"A": [{"destination": "B", "capacity": 7, "cost": 0}]})", 7, 0);
+    failures += !expectRejected("negative cost", R"({"A": [{"destination": "B", "capacity": 1, "cost": -1}]})");
+    failures += !expectRejected("negative energy", R"({"A": [{"destination": "B", "capacity": 1, "energy_wh": -0.2}]})");
+    failures += !expectRejected("negative distance", R"({"A": [{"destination": "B", "capacity": 1, "distance_km": -3}]})");
+    failures += !expectRejected("negative cost on a path",
+                                R"({"Source": [{"destination": "A", "capacity": 10, "cost": 1}],
+                                    "A": [{"destination": "B", "capacity": 10, "cost": -4}],
+                                    "B": [{"destination": "Sink", "capacity": 10, "cost": 8}]})");
+    failures += !expectRejected("malformed json", R"({"A": [{"destination": "B", "capacity": 1})");
+
+    cerr.clear();
+    cout << (failures == 0 ? "All loader checks passed" : to_string(failures) + " checks failed") << endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+#ifndef FLOW_RESULT_HPP
+#define FLOW_RESULT_HPP
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "flow_graph.hpp"
+
+// Work counters of one solve. augmentations counts the solver's unit of
+// progress: augmenting paths, pushes (push-relabel, cost scaling) or pivots
+// (network simplex).
+struct FlowStats {
+    long long augmentations = 0;
+    long long arcScans = 0;
+    double seconds = 0;             // Wall time of the solve alone, no I/O
+};
+
+// Outcome of a solve. Solvers fill it without printing anything; reporting
+// is a separate pass over the finished result.
+struct FlowResult {
+    long long value = 0;
+    long long cost = -1;            // Only set by min-cost solvers
+    std::vector<int> flow;          // Per arc; flow[graph.reverse[a]] == -flow[a]
+    FlowStats stats;
+
+    // Per-arc flow from a residual array: capacity minus what is left, which
+    // also gives the negated flow on reverse arcs
+    void setFlowFromResidual(const FlowGraph &graph, const std::vector<int> &residual) {
+        flow.resize(graph.numArcs());
+        for (int a = 0; a < graph.numArcs(); a++) flow[a] = graph.capacity[a] - residual[a];
+    }
+};
+
+// Times fn() on a steady clock and stores the elapsed seconds
+template <typename Fn>
+void timeSolve(FlowStats &stats, Fn &&fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Writes "  <from> to <to>: <flow>" for every edge carrying flow. The lines
+// are assembled in one buffer and written with a single call, so reporting
+// a large network costs one flush instead of one per edge.
+inline void reportFlowDistribution(std::ostream &out, const FlowGraph &graph, const FlowResult &result) {
+    std::string buffer;
+    buffer.reserve(64 * 1024);
+    for (int i = 0; i < graph.numEdges(); i++) {
+        int a = graph.inputArc[i];
+        if (result.flow[a] <= 0) continue;
+        buffer += "  ";
+        buffer += graph.nodeName(graph.tail(a));
+        buffer += " to ";
+        buffer += graph.nodeName(graph.head[a]);
+        buffer += ": ";
+        buffer += std::to_string(result.flow[a]);
+        buffer += '\n';
+    }
+    out.write(buffer.data(), buffer.size());
+}
+
+#endif // FLOW_RESULT_HPP
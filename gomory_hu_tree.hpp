@@ -0,0 +1,209 @@
+#ifndef GOMORY_HU_TREE_HPP
+#define GOMORY_HU_TREE_HPP
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include "batch_max_flow.hpp"
+#include "flow_graph.hpp"
+#include "min_cut.hpp"
+
+// Copy of the graph in which every edge can be used in both directions with
+// its full capacity (the reverse arc gets the forward capacity). Cut trees
+// only exist for such symmetric networks; antiparallel edges add up.
+inline FlowGraph undirectedFlowGraph(const FlowGraph &graph) {
+    FlowGraph result = graph;
+    std::vector<int> capacity(graph.capacity.begin(), graph.capacity.end());
+    for (int a : graph.inputArc) capacity[graph.reverse[a]] = capacity[a];
+    result.capacity = std::move(capacity);
+    return result;
+}
+
+// Cut tree of the undirected version of a network, built with Gusfield's
+// equivalent-flow construction: n - 1 max flows on the original graph, and
+// after the flow for s only nodes j > s are re-parented. This is not the
+// contraction-based Gomory-Hu construction, and its edges need not be the
+// cuts themselves, but it is flow-equivalent: the min cut value between any
+// two nodes is the smallest weight on their tree path.
+//
+// Gusfield is sequential (the flow for node s uses the parents left by nodes
+// before it), so the build speculates: a round solves the next `threads`
+// nodes in parallel against the current parents with BatchMaxFlow, then
+// commits them in order. A node whose parent was changed by an earlier commit
+// of the same round is solved again before it is committed, which keeps the
+// result identical to the sequential algorithm. One BatchMaxFlow serves every
+// round, so its threads and residual buffers are set up once per build.
+class GomoryHuTree {
+private:
+    std::vector<int> depth;
+
+    // Depth of every node below the root; false if the parents form a cycle
+    bool computeDepths() {
+        const int UNKNOWN = -1, ON_CHAIN = -2;
+        size_t n = parent.size();
+        depth.assign(n, UNKNOWN);
+        std::vector<NodeId> chain;
+        for (NodeId u = 0; u < n; u++) {
+            NodeId v = u;
+            while (depth[v] == UNKNOWN && parent[v] != INVALID_NODE) {
+                depth[v] = ON_CHAIN;
+                chain.push_back(v);
+                v = parent[v];
+            }
+            if (depth[v] == ON_CHAIN) return false;
+            if (depth[v] == UNKNOWN) depth[v] = 0;
+            for (size_t i = chain.size(); i-- > 0;) depth[chain[i]] = depth[parent[chain[i]]] + 1;
+            chain.clear();
+        }
+        return true;
+    }
+
+public:
+    std::vector<NodeId> parent;             // INVALID_NODE at the root (node 0)
+    std::vector<long long> weight;          // Min cut between u and parent[u]
+    long long maxFlowCalls = 0, recomputed = 0;
+
+    template <typename Solver = Dinic>
+    void build(const FlowGraph &graph, unsigned threads = 0) {
+        NodeId n = graph.numNodes;
+        FlowGraph undirected = undirectedFlowGraph(graph);
+        parent.assign(n, 0);
+        weight.assign(n, 0);
+        maxFlowCalls = recomputed = 0;
+        if (n > 0) parent[0] = INVALID_NODE;
+
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        BatchMaxFlow<Solver> batch(undirected, threads);
+        std::vector<std::vector<char>> sides(threads);
+        std::vector<std::vector<NodeId>> queues(threads);
+        std::vector<FlowQuery> queries;
+
+        for (NodeId first = 1; first < n; first += threads) {
+            NodeId last = std::min<NodeId>(n, first + threads);
+            queries.clear();
+            for (NodeId s = first; s < last; s++) queries.push_back({s, parent[s]});
+
+            std::vector<FlowResult> results = batch.run(queries, [&](size_t i, const FlowResult &, const std::vector<int> &residual) {
+                markReachable(undirected, queries[i].source, [&](int a) { return residual[a] > 0; }, sides[i], queues[i]);
+            });
+            maxFlowCalls += queries.size();
+
+            for (size_t i = 0; i < queries.size(); i++) {
+                NodeId s = queries[i].source;
+                if (parent[s] != queries[i].sink) {
+                    // An earlier node of this round moved s under itself
+                    std::vector<FlowResult> again = batch.run({{s, parent[s]}}, [&](size_t, const FlowResult &, const std::vector<int> &residual) {
+                        markReachable(undirected, s, [&](int a) { return residual[a] > 0; }, sides[i], queues[i]);
+                    });
+                    results[i] = again[0];
+                    maxFlowCalls++;
+                    recomputed++;
+                }
+                NodeId t = parent[s];
+                weight[s] = results[i].value;
+                for (NodeId j = s + 1; j < n; j++) {
+                    if (sides[i][j] && parent[j] == t) parent[j] = s;
+                }
+            }
+        }
+        computeDepths();
+    }
+
+    // Min cut between u and v: the lightest edge on their tree path. A node
+    // is not separated from itself, so minCut(u, u) is 0.
+    long long minCut(NodeId u, NodeId v) const {
+        if (u >= parent.size() || v >= parent.size() || u == v) return 0;
+        long long result = std::numeric_limits<long long>::max();
+        while (u != v) {
+            if (depth[u] < depth[v]) std::swap(u, v);
+            result = std::min(result, weight[u]);
+            u = parent[u];
+        }
+        return result;
+    }
+
+    // Text format, one line per node after a header:
+    //   gomory-hu-tree 1 <n>
+    //   <parent line or -1> <weight> <node name>
+    // Nodes are stored by name, so the tree can be loaded against any copy of
+    // the network, including a converted binary one.
+    bool save(const std::string &filename, const FlowGraph &graph) const {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file) {
+            std::cerr << "Error: cannot write " << filename << std::endl;
+            return false;
+        }
+        std::string buffer = "gomory-hu-tree 1 " + std::to_string(parent.size()) + "\n";
+        for (NodeId u = 0; u < parent.size(); u++) {
+            buffer += parent[u] == INVALID_NODE ? "-1" : std::to_string(parent[u]);
+            buffer += ' ';
+            buffer += std::to_string(weight[u]);
+            buffer += ' ';
+            buffer += graph.nodeName(u);
+            buffer += '\n';
+        }
+        file.write(buffer.data(), buffer.size());
+        return (bool)file;
+    }
+
+    bool load(const std::string &filename, const FlowGraph &graph) {
+        std::ifstream file(filename);
+        std::string magic;
+        int version = 0;
+        size_t n = 0;
+        if (!(file >> magic >> version >> n) || magic != "gomory-hu-tree" || version != 1) {
+            std::cerr << "Error: " << filename << " is not a cut tree file" << std::endl;
+            return false;
+        }
+        if (n != graph.numNodes) {
+            std::cerr << "Error: " << filename << " has " << n << " nodes, the network has " << graph.numNodes << std::endl;
+            return false;
+        }
+
+        std::vector<long long> lineParent(n);
+        std::vector<long long> lineWeight(n);
+        std::vector<NodeId> nodeOfLine(n);
+        std::string name;
+        std::vector<char> listed(n, false);
+        size_t roots = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (!(file >> lineParent[i] >> lineWeight[i]) || lineParent[i] < -1 || lineParent[i] >= (long long)n ||
+                lineParent[i] == (long long)i || lineWeight[i] < 0) {
+                std::cerr << "Error: " << filename << ": bad parent or weight on line " << i + 2 << std::endl;
+                return false;
+            }
+            file.get();
+            if (!std::getline(file, name) || (nodeOfLine[i] = graph.nodeId(name)) == INVALID_NODE || listed[nodeOfLine[i]]) {
+                std::cerr << "Error: " << filename << ": unknown or repeated node on line " << i + 2 << std::endl;
+                return false;
+            }
+            listed[nodeOfLine[i]] = true;
+            roots += lineParent[i] == -1;
+        }
+        if (n > 0 && roots != 1) {
+            std::cerr << "Error: " << filename << " has " << roots << " roots, a cut tree has one" << std::endl;
+            return false;
+        }
+
+        parent.assign(n, INVALID_NODE);
+        weight.assign(n, 0);
+        for (size_t i = 0; i < n; i++) {
+            NodeId u = nodeOfLine[i];
+            if (lineParent[i] >= 0) parent[u] = nodeOfLine[lineParent[i]];
+            weight[u] = lineWeight[i];
+        }
+        if (!computeDepths()) {
+            std::cerr << "Error: " << filename << ": the parent links form a cycle" << std::endl;
+            parent.clear();
+            weight.clear();
+            depth.clear();
+            return false;
+        }
+        return true;
+    }
+};
+
+#endif // GOMORY_HU_TREE_HPP
@@ -0,0 +1,274 @@
+#ifndef INCREMENTAL_MAX_FLOW_HPP
+#define INCREMENTAL_MAX_FLOW_HPP
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include "augmenting_paths.hpp"
+#include "flow_graph.hpp"
+#include "flow_result.hpp"
+
+// Change to the capacity of one input edge (graph.inputArc order)
+struct CapacityChange {
+    int edge;
+    int delta;                      // Capacities are clamped at zero
+};
+
+// Max flow kept up to date while edge capacities change.
+//
+// The solver owns a copy of the capacities and the residual of the last
+// solve, so the FlowGraph itself stays read-only (and may be memory-mapped).
+// applyChanges() starts from the previous flow instead of zero:
+//   - an increase only adds residual capacity on the arc;
+//   - a decrease below the current flow cuts the arc's flow back to the new
+//     capacity, which leaves a surplus at its tail and a deficit at its head.
+//     Each surplus is routed over residual arcs to a deficit, the sink or
+//     back to the source, and each remaining deficit is refilled from the
+//     sink (or the source, when the cut flow had passed through the sink);
+//   - the old flow was maximum, so a new augmenting path must use an arc
+//     whose residual grew during the batch: an increased arc, or the reverse
+//     of an arc that repair pushed along. A batch that opened none is done.
+//     Otherwise bidirectional searches from the source and the sink augment
+//     until they no longer meet; each costs about twice the smaller side.
+// All searches stamp nodes with an epoch instead of clearing arrays, so
+// their cost follows the part of the graph they reach, not its size.
+class IncrementalMaxFlow {
+private:
+    const FlowGraph &graph;
+    std::vector<int> capacity, residual;
+    std::vector<long long> imbalance;       // Inflow minus outflow, nonzero only while repairing
+    std::vector<NodeId> unbalanced;
+    std::vector<int> parentArc, childArc;   // Forward and backward search trees
+    std::vector<unsigned> seen, seenBack;
+    std::vector<NodeId> queue, backQueue;
+    std::vector<int> opened;                // Arcs whose residual grew in this batch
+    unsigned epoch = 0;
+    NodeId source = INVALID_NODE, sink = INVALID_NODE;
+    long long flowValue = 0;
+
+    void addImbalance(NodeId node, long long amount) {
+        if (node == source || node == sink) return;
+        if (imbalance[node] == 0) unbalanced.push_back(node);
+        imbalance[node] += amount;
+    }
+
+    void nextEpoch() {
+        if (++epoch == 0) {
+            std::fill(seen.begin(), seen.end(), 0);
+            std::fill(seenBack.begin(), seenBack.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    // BFS over residual arcs from `from` to the first node accepted by
+    // isTarget. parentArc is valid for the nodes stamped with this epoch.
+    template <typename IsTarget>
+    NodeId search(NodeId from, IsTarget isTarget) {
+        nextEpoch();
+        queue.clear();
+        queue.push_back(from);
+        seen[from] = epoch;
+        for (size_t i = 0; i < queue.size(); i++) {
+            NodeId node = queue[i];
+            for (int a = graph.offset[node]; a < graph.offset[node + 1]; a++) {
+                arcScans++;
+                NodeId next = graph.head[a];
+                if (residual[a] <= 0 || seen[next] == epoch) continue;
+                seen[next] = epoch;
+                parentArc[next] = a;
+                if (isTarget(next)) return next;
+                queue.push_back(next);
+            }
+        }
+        return INVALID_NODE;
+    }
+
+    void pushArc(int a, long long amount) {
+        residual[a] -= (int)amount;
+        residual[graph.reverse[a]] += (int)amount;
+    }
+
+    // Pushes up to limit units along the path found by search; returns the
+    // amount. The reverse arcs gain residual, so they count as opened.
+    long long pushPath(NodeId from, NodeId to, long long limit) {
+        long long amount = limit;
+        for (NodeId v = to; v != from; v = graph.tail(parentArc[v])) amount = std::min<long long>(amount, residual[parentArc[v]]);
+        for (NodeId v = to; v != from; v = graph.tail(parentArc[v])) {
+            pushArc(parentArc[v], amount);
+            opened.push_back(graph.reverse[parentArc[v]]);
+        }
+        augmentations++;
+        return amount;
+    }
+
+    // Bidirectional BFS for an augmenting path: forward from the source and
+    // backwards from the sink, one node each in turn, until the two sides
+    // meet or one of them runs out. That costs about twice the smaller side,
+    // where a Dinic phase scans the whole source side and resets arrays over
+    // every node. Returns the meeting node, from which parentArc leads back
+    // to the source and childArc on to the sink, or INVALID_NODE.
+    NodeId meetingNode() {
+        nextEpoch();
+        queue.assign(1, source);
+        backQueue.assign(1, sink);
+        seen[source] = epoch;
+        seenBack[sink] = epoch;
+        for (size_t i = 0, j = 0; i < queue.size() && j < backQueue.size(); i++, j++) {
+            NodeId node = queue[i];
+            for (int a = graph.offset[node]; a < graph.offset[node + 1]; a++) {
+                arcScans++;
+                NodeId next = graph.head[a];
+                if (residual[a] <= 0 || seen[next] == epoch) continue;
+                parentArc[next] = a;
+                if (seenBack[next] == epoch) return next;
+                seen[next] = epoch;
+                queue.push_back(next);
+            }
+            node = backQueue[j];
+            for (int b = graph.offset[node]; b < graph.offset[node + 1]; b++) {
+                arcScans++;
+                int a = graph.reverse[b];       // Arc from head[b] into node
+                NodeId prev = graph.head[b];
+                if (residual[a] <= 0 || seenBack[prev] == epoch) continue;
+                childArc[prev] = a;
+                if (seen[prev] == epoch) return prev;
+                seenBack[prev] = epoch;
+                backQueue.push_back(prev);
+            }
+        }
+        return INVALID_NODE;
+    }
+
+    // Pushes the bottleneck along source -> meet -> sink
+    void augmentThrough(NodeId meet) {
+        long long amount = std::numeric_limits<int>::max();
+        for (NodeId v = meet; v != source; v = graph.tail(parentArc[v])) amount = std::min<long long>(amount, residual[parentArc[v]]);
+        for (NodeId v = meet; v != sink; v = graph.head[childArc[v]]) amount = std::min<long long>(amount, residual[childArc[v]]);
+        for (NodeId v = meet; v != source; v = graph.tail(parentArc[v])) pushArc(parentArc[v], amount);
+        for (NodeId v = meet; v != sink; v = graph.head[childArc[v]]) pushArc(childArc[v], amount);
+        augmentations++;
+    }
+
+    // Returns false if some imbalance could not be routed, which a valid
+    // flow rules out: tracing flow back from a surplus, or on from a
+    // deficit, always ends at a terminal or at an opposite imbalance.
+    bool repair() {
+        auto isTerminal = [&](NodeId v) { return v == source || v == sink; };
+        bool balanced = true;
+        // Surplus nodes send flow on to a deficit node, the sink or back to the source
+        for (NodeId u : unbalanced) {
+            while (imbalance[u] > 0) {
+                NodeId target = search(u, [&](NodeId v) { return isTerminal(v) || imbalance[v] < 0; });
+                if (target == INVALID_NODE) break;
+                long long limit = imbalance[u];
+                if (!isTerminal(target)) limit = std::min(limit, -imbalance[target]);
+                long long moved = pushPath(u, target, limit);
+                imbalance[u] -= moved;
+                if (!isTerminal(target)) imbalance[target] += moved;
+            }
+            balanced = balanced && imbalance[u] <= 0;
+        }
+        // What is still missing at a deficit node comes from the sink, or
+        // from the source when the lost flow went around the sink
+        for (NodeId v : unbalanced) {
+            for (NodeId from : {sink, source}) {
+                while (imbalance[v] < 0 && search(from, [&](NodeId w) { return w == v; }) != INVALID_NODE) {
+                    imbalance[v] += pushPath(from, v, -imbalance[v]);
+                }
+            }
+            balanced = balanced && imbalance[v] == 0;
+        }
+        clearImbalances();
+        return balanced;
+    }
+
+    void clearImbalances() {
+        for (NodeId u : unbalanced) imbalance[u] = 0;
+        unbalanced.clear();
+    }
+
+    // Net flow leaving the source
+    long long sourceOutflow() const {
+        long long total = 0;
+        for (int a = graph.offset[source]; a < graph.offset[source + 1]; a++) total += capacity[a] - residual[a];
+        return total;
+    }
+
+public:
+    // Work done by the last solve() or applyChanges()
+    long long augmentations = 0, arcScans = 0;
+
+    explicit IncrementalMaxFlow(const FlowGraph &g)
+        : graph(g), capacity(g.capacity.begin(), g.capacity.end()), imbalance(g.numNodes, 0),
+          parentArc(g.numNodes, -1), childArc(g.numNodes, -1), seen(g.numNodes, 0), seenBack(g.numNodes, 0) {}
+
+    // Full solve from zero flow
+    long long solve(NodeId s, NodeId t) {
+        source = s;
+        sink = t;
+        residual = capacity;
+        Dinic dinic(graph, residual);
+        flowValue = dinic.maxFlow(source, sink);
+        augmentations = dinic.augmentations;
+        arcScans = dinic.arcScans;
+        return flowValue;
+    }
+
+    // Applies a batch of capacity changes and restores a maximum flow from
+    // the previous one. Returns the new flow value.
+    long long applyChanges(const std::vector<CapacityChange> &changes) {
+        augmentations = arcScans = 0;
+        for (const CapacityChange &change : changes) {
+            if (change.edge < 0 || change.edge >= graph.numEdges()) {
+                std::cerr << "Error: capacity change for unknown edge " << change.edge << ", batch ignored" << std::endl;
+                return flowValue;
+            }
+        }
+        opened.clear();
+        for (const CapacityChange &change : changes) {
+            int a = graph.inputArc[change.edge];
+            int flow = capacity[a] - residual[a];
+            capacity[a] = std::max(0, capacity[a] + change.delta);
+            if (flow <= capacity[a]) {
+                if (capacity[a] - flow > residual[a]) opened.push_back(a);
+                residual[a] = capacity[a] - flow;
+                continue;
+            }
+            int excess = flow - capacity[a];
+            residual[a] = 0;
+            residual[graph.reverse[a]] -= excess;
+            addImbalance(graph.tail(a), excess);
+            addImbalance(graph.head[a], -excess);
+        }
+        if (source == sink) {
+            clearImbalances();
+            return flowValue = 0;
+        }
+        if (!repair()) {
+            std::cerr << "Error: could not reroute the flow cut by a capacity change, solving from scratch" << std::endl;
+            return solve(source, sink);
+        }
+
+        if (std::any_of(opened.begin(), opened.end(), [&](int a) { return residual[a] > 0; })) {
+            for (NodeId meet = meetingNode(); meet != INVALID_NODE; meet = meetingNode()) augmentThrough(meet);
+        }
+        return flowValue = sourceOutflow();
+    }
+
+    long long value() const { return flowValue; }
+    int edgeCapacity(int edge) const { return capacity[graph.inputArc[edge]]; }
+
+    // Current flow with the per-arc values, in the FlowResult layout
+    FlowResult result() const {
+        FlowResult result;
+        result.value = flowValue;
+        result.flow.resize(graph.numArcs());
+        for (int a = 0; a < graph.numArcs(); a++) result.flow[a] = capacity[a] - residual[a];
+        result.stats.augmentations = augmentations;
+        result.stats.arcScans = arcScans;
+        return result;
+    }
+};
+
+#endif // INCREMENTAL_MAX_FLOW_HPP
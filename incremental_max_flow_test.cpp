@@ -0,0 +1,104 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "augmenting_paths.hpp"
+#include "flow_graph.hpp"
+#include "incremental_max_flow.hpp"
+
+using namespace std;
+
+// Regression test for IncrementalMaxFlow: after every batch of capacity
+// changes the stored flow must respect the capacities, conserve flow at
+// every node except Source and Sink, and match a fresh Dinic solve. The
+// random graphs include self-loops, arcs leaving the sink and arcs entering
+// the source, so repaired flow may have to pass through a terminal.
+
+FlowGraph buildGraph(int n, const vector<vector<int>> &edges) {
+    FlowGraphBuilder builder;
+    for (int u = 0; u < n; u++) builder.addNode("n" + to_string(u));
+    for (const auto &e : edges) builder.addEdge(e[0], e[1], e[2]);
+    return builder.build();
+}
+
+// Empty if the incremental solution is correct, otherwise what is wrong
+string checkFlow(const FlowGraph &graph, const IncrementalMaxFlow &solver, NodeId s, NodeId t) {
+    FlowResult result = solver.result();
+    vector<long long> net(graph.numNodes, 0);
+    for (int i = 0; i < graph.numEdges(); i++) {
+        int a = graph.inputArc[i];
+        int f = result.flow[a];
+        if (f < 0 || f > solver.edgeCapacity(i)) return "edge " + to_string(i) + " carries " + to_string(f);
+        net[graph.tail(a)] -= f;
+        net[graph.head[a]] += f;
+    }
+    for (NodeId u = 0; u < graph.numNodes; u++) {
+        if (u != s && u != t && net[u] != 0) return "node " + to_string(u) + " is unbalanced by " + to_string(net[u]);
+    }
+    if (-net[s] != solver.value()) return "value " + to_string(solver.value()) + " but source sends " + to_string(-net[s]);
+
+    vector<int> residual(graph.numArcs(), 0);
+    for (int i = 0; i < graph.numEdges(); i++) residual[graph.inputArc[i]] = solver.edgeCapacity(i);
+    long long expected = s == t ? 0 : Dinic(graph, residual).maxFlow(s, t);
+    if (expected != solver.value()) return "value " + to_string(solver.value()) + ", expected " + to_string(expected);
+    return "";
+}
+
+bool runCase(const string &name, int n, const vector<vector<int>> &edges, NodeId s, NodeId t,
+             const vector<vector<CapacityChange>> &batches) {
+    FlowGraph graph = buildGraph(n, edges);
+    IncrementalMaxFlow solver(graph);
+    solver.solve(s, t);
+    string error = checkFlow(graph, solver, s, t);
+    for (size_t b = 0; b < batches.size() && error.empty(); b++) {
+        solver.applyChanges(batches[b]);
+        error = checkFlow(graph, solver, s, t);
+        if (!error.empty()) error = "after batch " + to_string(b) + ": " + error;
+    }
+    if (!error.empty()) cout << name << " failed " << error << "\n";
+    return error.empty();
+}
+
+int main() {
+    int failures = 0;
+
+    // Flow that leaves the sink again and comes back through node 2
+    failures += !runCase("sink outflow", 3, {{1, 1, 5}, {1, 1, 4}, {1, 2, 4}, {0, 2, 3}, {2, 1, 5}}, 0, 1,
+                         {{{1, 4}, {4, -4}}});
+    // Flow that returns into the source
+    failures += !runCase("source inflow", 4, {{0, 2, 5}, {2, 0, 3}, {2, 3, 4}, {3, 1, 4}, {1, 3, 2}}, 0, 1,
+                         {{{2, -3}}, {{2, 3}, {4, -2}}, {{0, -5}}});
+
+    // Out-of-range edge indices reject the whole batch and keep the flow
+    {
+        FlowGraph graph = buildGraph(3, {{0, 2, 5}, {2, 1, 4}});
+        IncrementalMaxFlow solver(graph);
+        solver.solve(0, 1);
+        cerr.setstate(ios::failbit);
+        bool rejected = solver.applyChanges({{1, 3}, {2, 1}}) == 4 && solver.applyChanges({{-1, -4}}) == 4;
+        cerr.clear();
+        string error = checkFlow(graph, solver, 0, 1);
+        if (!rejected || solver.edgeCapacity(1) != 4 || !error.empty()) {
+            cout << "bad edge index failed " << error << "\n";
+            failures++;
+        }
+    }
+
+    mt19937 rng(12345);
+    for (int trial = 0; trial < 3000; trial++) {
+        int n = 2 + rng() % 7;
+        int m = 1 + rng() % 14;
+        vector<vector<int>> edges;
+        for (int i = 0; i < m; i++) edges.push_back({(int)(rng() % n), (int)(rng() % n), (int)(rng() % 8)});
+        NodeId s = rng() % n, t = rng() % n;
+        vector<vector<CapacityChange>> batches(1 + rng() % 4);
+        for (auto &batch : batches) {
+            int changes = 1 + rng() % 4;
+            for (int c = 0; c < changes; c++) batch.push_back({(int)(rng() % m), (int)(rng() % 13) - 6});
+        }
+        failures += !runCase("random trial " + to_string(trial), n, edges, s, t, batches);
+    }
+
+    cout << (failures == 0 ? "All incremental max flow checks passed" : to_string(failures) + " checks failed") << endl;
+    return failures == 0 ? 0 : 1;
+}
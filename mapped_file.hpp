@@ -0,0 +1,143 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Memory mapping of a whole file: read-only for an existing file, or
+// writable for a new file of a given size. The mapping lives as long as the
+// object, so anything viewing its bytes must keep it alive.
+class MappedFile {
+private:
+    const char *bytes = nullptr;
+    size_t length = 0;
+    bool writable = false;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+
+public:
+    void close() {
+#ifdef _WIN32
+        if (bytes) UnmapViewOfFile(bytes);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (bytes) munmap(const_cast<char *>(bytes), length);
+        if (fd != -1) ::close(fd);
+        fd = -1;
+#endif
+        bytes = nullptr;
+        length = 0;
+        writable = false;
+    }
+
+    MappedFile() {}
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const std::string &filename) {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            close();
+            return false;
+        }
+        length = (size_t)size.QuadPart;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            close();
+            return false;
+        }
+        bytes = (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!bytes) {
+            close();
+            return false;
+        }
+#else
+        fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd == -1) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            close();
+            return false;
+        }
+        length = (size_t)info.st_size;
+        void *addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            close();
+            return false;
+        }
+        bytes = (const char *)addr;
+#endif
+        return true;
+    }
+
+    // Create (or truncate) filename to size bytes and map it for writing;
+    // the contents reach the file when the mapping is closed
+    bool create(const std::string &filename, size_t size) {
+        close();
+        if (size == 0) return false;
+        length = size;
+#ifdef _WIN32
+        file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, (DWORD)((uint64_t)size >> 32),
+                                     (DWORD)(size & 0xFFFFFFFF), nullptr);
+        if (!mapping) {
+            close();
+            return false;
+        }
+        bytes = (const char *)MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0);
+        if (!bytes) {
+            close();
+            return false;
+        }
+#else
+        fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1) return false;
+        if (ftruncate(fd, (off_t)size) != 0) {
+            close();
+            return false;
+        }
+        void *addr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED) {
+            close();
+            return false;
+        }
+        bytes = (const char *)addr;
+#endif
+        writable = true;
+        return true;
+    }
+
+    const char *data() const { return bytes; }
+    char *writableData() { return writable ? const_cast<char *>(bytes) : nullptr; }
+    size_t size() const { return length; }
+};
+
+#endif // MAPPED_FILE_HPP
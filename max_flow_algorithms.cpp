@@ -1,191 +1,261 @@
 #include <iostream>
+#include <algorithm>
 #include <vector>
-#include <unordered_map>
-#include <queue>
-#include <fstream>
-#include <chrono>
-#include <limits>
+#include <string>
 #include <iomanip>
-#include "json.hpp"
+#include <sstream>
+#include "flow_graph.hpp"
+#include "flow_result.hpp"
+#include "augmenting_paths.hpp"
+#include "push_relabel.hpp"
+#include "batch_max_flow.hpp"
+#include "dynamic_network.hpp"
+#include "gomory_hu_tree.hpp"
+#include "min_cut.hpp"
+#include "command_line.hpp"
 
 using namespace std;
-using json = nlohmann::json;
 
 class MaxFlowAlgorithms {
 private:
-    unordered_map<string, unordered_map<string, int>> capacity, residualCapacity;
-    unordered_map<string, vector<string>> adjList;
+    FlowGraph graph;
     string network_file;
+    bool quiet;
+    bool loaded = false;
+
+    // Resolve the terminals; false (and an empty result) if either is unknown
+    bool terminals(const string& source, const string& sink, NodeId& s, NodeId& t) {
+        s = graph.nodeId(source);
+        t = graph.nodeId(sink);
+        return s != INVALID_NODE && t != INVALID_NODE;
+    }
+
+    // Runs a max flow solver class on a fresh residual graph, timing only the solve
+    template <typename Solver>
+    FlowResult solve(const string& source, const string& sink) {
+        FlowResult result;
+        NodeId s, t;
+        if (!terminals(source, sink, s, t)) return result;
+
+        vector<int> residualCapacity(graph.capacity.begin(), graph.capacity.end());
+        Solver solver(graph, residualCapacity);
+        timeSolve(result.stats, [&] { result.value = solver.maxFlow(s, t); });
+        result.stats.augmentations = solver.augmentations;
+        result.stats.arcScans = solver.arcScans;
+        result.setFlowFromResidual(graph, residualCapacity);
+        return result;
+    }
 
 public:
-    MaxFlowAlgorithms(string filename = "network.json") : network_file(filename) {
+    MaxFlowAlgorithms(string filename = "network.json", bool quietMode = false) : network_file(filename), quiet(quietMode) {
         loadNetwork();
     }
 
-    void loadNetwork() {
-        ifstream file(network_file);
-        if (!file) {
-            cerr << "Error: " << network_file << " not found!" << endl;
-            return;
+    bool loadNetwork() {
+        loaded = loadFlowGraph(network_file, graph);
+        if (!loaded) {
+            cerr << "Error: failed to load " << network_file << endl;
+            return false;
         }
+        cout << "Network loaded from " << network_file << endl;
+        return true;
+    }
 
-        json networkData;
-        file >> networkData;
-        file.close();
-
-        capacity.clear();
-        residualCapacity.clear();
-        adjList.clear();
-
-        for (auto& node : networkData.items()) {
-            string from = node.key();
-            for (auto& edge : node.value()) {
-                string to = edge["destination"];
-                int cap = edge["capacity"];
-                capacity[from][to] = cap;
-                residualCapacity[from][to] = cap;
-                residualCapacity[to][from] = 0; // Initialize reverse edge with 0
-                adjList[from].push_back(to);
-                adjList[to].push_back(from);
-            }
-        }
+    bool isLoaded() const { return loaded; }
 
-        cout << "Network loaded from " << network_file << endl;
+    FlowResult edmondsKarp(const string& source, const string& sink) { return solve<EdmondsKarp>(source, sink); }
+
+    FlowResult fordFulkerson(const string& source, const string& sink) { return solve<FordFulkerson>(source, sink); }
+
+    FlowResult dinic(const string& source, const string& sink) { return solve<Dinic>(source, sink); }
+
+    FlowResult pushRelabel(const string& source, const string& sink) {
+        FlowResult result;
+        NodeId s, t;
+        if (!terminals(source, sink, s, t)) return result;
+
+        vector<int> residualCapacity(graph.capacity.begin(), graph.capacity.end());
+        PushRelabel solver(graph, residualCapacity);
+        timeSolve(result.stats, [&] { result.value = solver.maxFlow(s, t); });
+        result.stats.augmentations = solver.pushes;
+        result.stats.arcScans = solver.arcScans;
+        result.setFlowFromResidual(graph, residualCapacity);
+        return result;
     }
 
-    int bfs(unordered_map<string, string>& parent, string source, string sink) {
-        parent.clear();
-        queue<pair<string, int>> q;
-        q.push({source, numeric_limits<int>::max()});
+    // Reporting pass, run after all timing is done
+    void report(const string& name, const FlowResult& result) {
+        cout << "Max Flow (" << name << "): " << result.value << "\n";
+        if (quiet) return;
+        cout << "Flow Distribution (" << name << "):\n";
+        reportFlowDistribution(cout, graph, result);
+    }
 
-        while (!q.empty()) {
-            string node = q.front().first;
-            int flow = q.front().second;
-            q.pop();
+    void compareAlgorithms() {
+        string source = "Source", sink = "Sink";
 
-            for (auto& next : adjList[node]) {
-                if (parent.find(next) == parent.end() && residualCapacity[node][next] > 0) {
-                    parent[next] = node;
-                    int new_flow = min(flow, residualCapacity[node][next]);
+        vector<pair<string, FlowResult>> results;
+        results.push_back({"Ford-Fulkerson", fordFulkerson(source, sink)});
+        results.push_back({"Edmonds-Karp", edmondsKarp(source, sink)});
+        results.push_back({"Dinic", dinic(source, sink)});
+        results.push_back({"Push-Relabel", pushRelabel(source, sink)});
 
-                    //cout << "Exploring edge " << node << " to " << next << " with flow " << new_flow << endl;
+        for (const auto& entry : results) {
+            cout << "\n";
+            report(entry.first, entry.second);
+        }
 
-                    if (next == sink) return new_flow;
-                    q.push({next, new_flow});
-                }
-            }
+        // The cut is the same for every solver; take it from Edmonds-Karp
+        NodeId s = graph.nodeId(source);
+        if (s != INVALID_NODE && !results[1].second.flow.empty()) {
+            cout << "\n";
+            reportMinCut(cout, graph, extractMinCut(graph, results[1].second, s), !quiet);
+        }
+
+        vector<pair<string, double>> timings = {
+            {"Ford-Fulkerson (DFS)", results[0].second.stats.seconds},
+            {"Edmonds-Karp (BFS)", results[1].second.stats.seconds},
+            {"Dinic (Level Graph)", results[2].second.stats.seconds},
+            {"Push-Relabel (Highest Label)", results[3].second.stats.seconds},
+        };
+
+        cout << "\n===== Algorithm Performance Comparison =====" << "\n";
+        for (size_t i = 0; i < timings.size(); i++) {
+            const FlowStats& stats = results[i].second.stats;
+            cout << timings[i].first << " Execution Time: " << fixed << setprecision(8) << timings[i].second << " seconds"
+                 << " | Augmentations: " << stats.augmentations << " | Arc scans: " << stats.arcScans << "\n";
         }
-        return 0;
+
+        auto fastest = min_element(timings.begin(), timings.end(),
+                                   [](const pair<string, double>& a, const pair<string, double>& b) { return a.second < b.second; });
+        cout << fastest->first << " is fastest on this network." << endl;
     }
 
-    int edmondsKarp(string source, string sink) {
-        unordered_map<string, string> parent;
-        int maxFlow = 0;
-        residualCapacity = capacity; // Reset residual graph
-
-        auto start = chrono::high_resolution_clock::now();
-        int flow;
-        while ((flow = bfs(parent, source, sink))) {
-            maxFlow += flow;
-            string cur = sink;
-
-            while (cur != source) {
-                string prev = parent[cur];
-                residualCapacity[prev][cur] -= flow;
-                residualCapacity[cur][prev] += flow; // Reverse flow
-                cur = prev;
-            }
+    // Max flow from every warehouse to every destination, spread over a
+    // thread pool that shares the graph
+    void warehouseDestinationFlows(unsigned threads) {
+        vector<NodeId> warehouses, destinations;
+        for (NodeId u = 0; u < graph.numNodes; u++) {
+            string_view name = graph.nodeName(u);
+            if (name.rfind("Warehouse_", 0) == 0) warehouses.push_back(u);
+            else if (name.rfind("Destination_", 0) == 0) destinations.push_back(u);
         }
-        auto end = chrono::high_resolution_clock::now();
-        double timeTaken = chrono::duration<double>(end - start).count();
-
-        cout << "Max Flow (Edmonds-Karp): " << maxFlow << endl;
-        cout << "Flow Distribution (Edmonds-Karp):" << endl;
-        for (const auto& from : capacity) {
-            for (const auto& edge : from.second) {
-                int usedFlow = capacity[from.first][edge.first] - residualCapacity[from.first][edge.first];
-                if (usedFlow > 0) {
-                    cout << "  " << from.first << " to " << edge.first << ": " << usedFlow << endl;
-                }
-            }
+
+        vector<FlowQuery> queries;
+        queries.reserve(warehouses.size() * destinations.size());
+        for (NodeId w : warehouses) {
+            for (NodeId d : destinations) queries.push_back({w, d});
         }
-        return maxFlow;
-    }
 
-    int dfs(string node, string sink, int flow, unordered_map<string, bool>& visited) {
-        if (node == sink) return flow;
-        visited[node] = true;
-
-        for (auto& next : adjList[node]) {
-            if (!visited[next] && residualCapacity[node][next] > 0) {
-                int new_flow = min(flow, residualCapacity[node][next]);
-                int result = dfs(next, sink, new_flow, visited);
-                if (result > 0) {
-                    residualCapacity[node][next] -= result;
-                    residualCapacity[next][node] += result;
-                    return result;
-                }
+        BatchMaxFlow<Dinic> batch(graph, threads);
+        vector<FlowResult> results;
+        FlowStats total;
+        timeSolve(total, [&] { results = batch.run(queries); });
+
+        if (!quiet) {
+            string buffer;
+            for (size_t i = 0; i < queries.size(); i++) {
+                buffer += "  ";
+                buffer += graph.nodeName(queries[i].source);
+                buffer += " to ";
+                buffer += graph.nodeName(queries[i].sink);
+                buffer += ": ";
+                buffer += to_string(results[i].value);
+                buffer += '\n';
             }
+            cout << "Warehouse to Destination Max Flows:\n";
+            cout.write(buffer.data(), buffer.size());
         }
-        return 0;
+        cout << "Solved " << queries.size() << " warehouse-destination pairs in " << fixed << setprecision(8)
+             << total.seconds << " seconds" << endl;
     }
 
-    int fordFulkerson(string source, string sink) {
-        int maxFlow = 0;
-        unordered_map<string, bool> visited;
-        residualCapacity = capacity;
-
-        auto start = chrono::high_resolution_clock::now();
-        while (int flow = dfs(source, sink, numeric_limits<int>::max(), visited)) {
-            maxFlow += flow;
-            visited.clear();
+    // Source-Sink max flow with the named nodes grounded. They are removed
+    // from a DynamicFlowNetwork over the loaded graph, so nothing is reloaded.
+    bool groundedFlow(const vector<string>& names) {
+        NodeId s = graph.nodeId("Source"), t = graph.nodeId("Sink");
+        if (s == INVALID_NODE || t == INVALID_NODE) {
+            cerr << "Error: the network has no Source or Sink" << endl;
+            return false;
         }
-        auto end = chrono::high_resolution_clock::now();
-        double timeTaken = chrono::duration<double>(end - start).count();
-
-        cout << "Max Flow (Ford-Fulkerson): " << maxFlow << endl;
-        cout << "Flow Distribution (Ford-Fulkerson):" << endl;
-        for (const auto& from : capacity) {
-            for (const auto& edge : from.second) {
-                int usedFlow = capacity[from.first][edge.first] - residualCapacity[from.first][edge.first];
-                if (usedFlow > 0) {
-                    cout << "  " << from.first << " to " << edge.first << ": " << usedFlow << endl;
-                }
+        vector<NodeId> grounded;
+        for (const string& name : names) {
+            NodeId u = graph.nodeId(name);
+            if (u == INVALID_NODE || u == s || u == t) {
+                cerr << "Error: cannot ground " << name << " (expected a node other than Source and Sink)" << endl;
+                return false;
             }
+            grounded.push_back(u);
         }
-        return maxFlow;
+
+        FlowResult before = dinic("Source", "Sink");
+        DynamicFlowNetwork network(graph);
+        for (NodeId u : grounded) network.removeNode(u);
+        vector<int> residualCapacity(network.graph().capacity.begin(), network.graph().capacity.end());
+        Dinic solver(network.graph(), residualCapacity);
+        FlowStats stats;
+        long long after = 0;
+        timeSolve(stats, [&] { after = solver.maxFlow(s, t); });
+
+        cout << "Max Flow (Dinic): " << before.value << "\n";
+        cout << "Max Flow with " << grounded.size() << " node(s) grounded: " << after << " (" << after - before.value
+             << ") in " << fixed << setprecision(8) << stats.seconds << " seconds" << endl;
+        return true;
     }
 
-    void compareAlgorithms() {
-        string source = "Source", sink = "Sink";
+    // Builds the cut tree of the undirected network and saves it for reuse
+    void buildCutTree(const string& filename, unsigned threads) {
+        GomoryHuTree tree;
+        FlowStats stats;
+        timeSolve(stats, [&] { tree.build(graph, threads); });
+        if (!tree.save(filename, graph)) return;
 
-        cout << "\nRunning Ford-Fulkerson Algorithm (DFS-based)..." << endl;
-        auto startFF = chrono::high_resolution_clock::now();
-        int maxFlowFF = fordFulkerson(source, sink);
-        auto endFF = chrono::high_resolution_clock::now();
-        double timeTakenFF = chrono::duration<double>(endFF - startFF).count();
-
-        cout << "\nRunning Edmonds-Karp Algorithm (BFS-based)..." << endl;
-        auto startEK = chrono::high_resolution_clock::now();
-        int maxFlowEK = edmondsKarp(source, sink);
-        auto endEK = chrono::high_resolution_clock::now();
-        double timeTakenEK = chrono::duration<double>(endEK - startEK).count();
-
-        cout << "\n===== Algorithm Performance Comparison =====" << endl;
-        cout << "Ford-Fulkerson (DFS) Execution Time: " << fixed << setprecision(8) << timeTakenFF << " seconds" << endl;
-        cout << "Edmonds-Karp (BFS) Execution Time: " << fixed << setprecision(8) << timeTakenEK << " seconds" << endl;
-
-        if (timeTakenEK < timeTakenFF)
-            cout << "Edmonds-Karp is faster on this network." << endl;
-        else if (timeTakenFF < timeTakenEK)
-            cout << "Ford-Fulkerson is faster on this network." << endl;
-        else
-            cout << "Both algorithms took the same time." << endl;
+        cout << "Gomory-Hu tree: " << graph.numNodes << " nodes, " << tree.maxFlowCalls << " max flows ("
+             << tree.recomputed << " recomputed) in " << fixed << setprecision(8) << stats.seconds << " seconds\n";
+        NodeId s = graph.nodeId("Source"), t = graph.nodeId("Sink");
+        if (s != INVALID_NODE && t != INVALID_NODE) cout << "Undirected Source-Sink min cut: " << tree.minCut(s, t) << "\n";
+        cout << "Saved to " << filename << endl;
     }
 };
 
-int main() {
-    MaxFlowAlgorithms maxFlowSolver("network.json");
-    maxFlowSolver.compareAlgorithms();
+int main(int argc, char* argv[]) {
+    string filename = "network.json";
+    bool quiet = false, pairs = false;
+    unsigned threads = 0;
+    string cutTreeFile;
+    vector<string> grounded;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--quiet" || arg == "-q") quiet = true;
+        else if (arg == "--pairs") pairs = true;
+        else if (arg.rfind("--cut-tree=", 0) == 0) cutTreeFile = arg.substr(11);
+        else if (arg.rfind("--ground=", 0) == 0) {
+            stringstream names(arg.substr(9));
+            string name;
+            while (getline(names, name, ',')) {
+                if (!name.empty()) grounded.push_back(name);
+            }
+            if (grounded.empty()) {
+                cerr << "Error: --ground needs a comma-separated list of node names" << endl;
+                return 1;
+            }
+        }
+        else if (arg.rfind("--threads=", 0) == 0) {
+            long long count = 0;
+            if (!parseInteger(arg.substr(10), count, 0, 1024)) {
+                cerr << "Error: Invalid thread count " << arg.substr(10) << " (expected 0 for all cores, or 1 to 1024)" << endl;
+                return 1;
+            }
+            threads = (unsigned)count;
+        }
+        else filename = arg;
+    }
+
+    MaxFlowAlgorithms maxFlowSolver(filename, quiet);
+    if (!maxFlowSolver.isLoaded()) return 1;
+    if (!grounded.empty()) return maxFlowSolver.groundedFlow(grounded) ? 0 : 1;
+    if (!cutTreeFile.empty()) maxFlowSolver.buildCutTree(cutTreeFile, threads);
+    else if (pairs) maxFlowSolver.warehouseDestinationFlows(threads);
+    else maxFlowSolver.compareAlgorithms();
     return 0;
 }
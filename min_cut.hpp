@@ -0,0 +1,100 @@
+#ifndef MIN_CUT_HPP
+#define MIN_CUT_HPP
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "flow_graph.hpp"
+#include "flow_result.hpp"
+
+// Marks the nodes reachable from s over arcs for which hasResidual(a) holds.
+// After a max flow these are the source side of a minimum cut. queue is
+// scratch space, passed in so repeated calls do not allocate.
+template <typename HasResidual>
+void markReachable(const FlowGraph &graph, NodeId s, HasResidual hasResidual, std::vector<char> &side, std::vector<NodeId> &queue) {
+    side.assign(graph.numNodes, false);
+    queue.assign(1, s);
+    side[s] = true;
+    for (size_t i = 0; i < queue.size(); i++) {
+        NodeId u = queue[i];
+        for (int a = graph.offset[u]; a < graph.offset[u + 1]; a++) {
+            NodeId v = graph.head[a];
+            if (!side[v] && hasResidual(a)) {
+                side[v] = true;
+                queue.push_back(v);
+            }
+        }
+    }
+}
+
+// Minimum cut of a finished max flow
+struct MinCut {
+    std::vector<char> sourceSide;   // Per node
+    std::vector<int> edges;         // Saturated input edges from the source side to the sink side
+    long long capacity = 0;         // Equals the flow value
+};
+
+// One BFS over the residual arcs plus one pass over the edges: O(V + E)
+inline MinCut extractMinCut(const FlowGraph &graph, const FlowResult &result, NodeId source) {
+    MinCut cut;
+    std::vector<NodeId> queue;
+    markReachable(graph, source, [&](int a) { return graph.capacity[a] > result.flow[a]; }, cut.sourceSide, queue);
+    for (int i = 0; i < graph.numEdges(); i++) {
+        int a = graph.inputArc[i];
+        if (cut.sourceSide[graph.tail(a)] && !cut.sourceSide[graph.head[a]]) {
+            cut.edges.push_back(i);
+            cut.capacity += graph.capacity[a];
+        }
+    }
+    return cut;
+}
+
+// Tier of a node in the Source -> Warehouse -> Drone -> Destination -> Sink
+// layout, from its name; 5 for anything else
+inline int networkTier(std::string_view name) {
+    static const char *const prefixes[] = {"Source", "Warehouse_", "Drone_", "Destination_", "Sink"};
+    for (int tier = 0; tier < 5; tier++) {
+        std::string_view prefix = prefixes[tier];
+        if (name.substr(0, prefix.size()) == prefix) return tier;
+    }
+    return 5;
+}
+
+// Lists the cut edges and how much capacity each kind of link contributes,
+// so a planner sees whether warehouses, drones or deliveries limit the
+// throughput. Written as one buffer.
+inline void reportMinCut(std::ostream &out, const FlowGraph &graph, const MinCut &cut, bool listEdges = true) {
+    static const char *const linkNames[] = {"Source to warehouse", "Warehouse to drone", "Drone to destination",
+                                            "Destination to sink", "Other"};
+    long long linkCapacity[5] = {0, 0, 0, 0, 0};
+    int linkCount[5] = {0, 0, 0, 0, 0};
+    std::string buffer;
+
+    for (int i : cut.edges) {
+        int a = graph.inputArc[i];
+        std::string_view from = graph.nodeName(graph.tail(a)), to = graph.nodeName(graph.head[a]);
+        int tier = networkTier(from);
+        int link = tier < 4 && networkTier(to) == tier + 1 ? tier : 4;
+        linkCapacity[link] += graph.capacity[a];
+        linkCount[link]++;
+        if (!listEdges) continue;
+        buffer += "  ";
+        buffer += from;
+        buffer += " to ";
+        buffer += to;
+        buffer += ": ";
+        buffer += std::to_string(graph.capacity[a]);
+        buffer += '\n';
+    }
+
+    buffer = "Min Cut: " + std::to_string(cut.capacity) + " over " + std::to_string(cut.edges.size()) + " saturated links\n" + buffer;
+    for (int link = 0; link < 5; link++) {
+        if (linkCount[link] == 0) continue;
+        buffer += "Bottleneck " + std::string(linkNames[link]) + ": " + std::to_string(linkCount[link]) + " links, capacity " +
+                  std::to_string(linkCapacity[link]) + "\n";
+    }
+    out.write(buffer.data(), buffer.size());
+}
+
+#endif // MIN_CUT_HPP
@@ -0,0 +1,222 @@
+#ifndef MULTI_COMMODITY_FLOW_HPP
+#define MULTI_COMMODITY_FLOW_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+#include "augmenting_paths.hpp"
+#include "flow_graph.hpp"
+
+// One package class routed from its own source to its own sink
+struct Commodity {
+    std::string name;
+    NodeId source = INVALID_NODE, sink = INVALID_NODE;
+    double demand = 0;
+};
+
+// Approximate maximum concurrent multi-commodity flow (Garg-Konemann, with
+// Fleischer's phases). Every commodity shares the edge capacities of the
+// FlowGraph, and the solver finds the largest lambda such that lambda times
+// every demand can be routed at once, to within a factor (1 - epsilon)^3.
+//
+// Each edge has a length that starts at delta / capacity. A phase routes
+// every commodity's demand along shortest paths under the current lengths,
+// one bottleneck at a time, and multiplies the length of each used edge by
+// (1 + epsilon * routed / capacity). Crowded edges therefore grow long and
+// later paths avoid them. The solve stops once sum(length * capacity)
+// reaches 1, and the accumulated flow is scaled down to fit the capacities.
+// Each step is one Dijkstra that stops at the sink, the same unit of work
+// as an SSP augmentation. A path is reused without a new search while it is
+// at most (1 + epsilon) times longer than it was when found.
+//
+// Demands are first rescaled so the optimal lambda lies in [1, k] for k
+// commodities, which bounds the number of phases by O(k log m / epsilon^2).
+// Rescaling uses one max flow per commodity. A commodity whose sink cannot
+// be reached at all is left out and routes nothing.
+class MultiCommodityFlow {
+private:
+    const FlowGraph &graph;
+    std::vector<double> length, dist;
+    std::vector<int> parentArc;
+    std::vector<NodeId> touched;
+
+    // Dijkstra on edge lengths from s, stopping when t is settled
+    bool shortestPath(NodeId s, NodeId t) {
+        for (NodeId u : touched) {
+            dist[u] = std::numeric_limits<double>::infinity();
+            parentArc[u] = -1;
+        }
+        touched.assign(1, s);
+        std::priority_queue<std::pair<double, NodeId>, std::vector<std::pair<double, NodeId>>, std::greater<std::pair<double, NodeId>>> pq;
+        dist[s] = 0;
+        pq.push({0, s});
+
+        while (!pq.empty()) {
+            auto [d, u] = pq.top();
+            pq.pop();
+            if (d != dist[u]) continue;
+            if (u == t) return true;
+            arcScans += graph.offset[u + 1] - graph.offset[u];
+            for (int a = graph.offset[u]; a < graph.offset[u + 1]; a++) {
+                if (graph.capacity[a] <= 0) continue; // Reverse arcs and closed edges
+                NodeId v = graph.head[a];
+                double nd = d + length[a];
+                if (nd < dist[v]) {
+                    if (parentArc[v] == -1 && v != s) touched.push_back(v);
+                    dist[v] = nd;
+                    parentArc[v] = a;
+                    pq.push({nd, v});
+                }
+            }
+        }
+        return false;
+    }
+
+    static constexpr double RESCALE_VOLUME = 1e100;
+
+    // Divides every length by RESCALE_VOLUME and recomputes the volume.
+    // Lengths never drop to zero, since a zero length could never grow.
+    void rescaleLengths(double &volume) {
+        volume = 0;
+        for (int a : graph.inputArc) {
+            if (graph.capacity[a] == 0) continue;
+            length[a] = std::max(length[a] / RESCALE_VOLUME, std::numeric_limits<double>::min());
+            volume += length[a] * graph.capacity[a];
+        }
+    }
+
+public:
+    double epsilon = 0.1;
+    long long augmentations = 0, arcScans = 0, phases = 0;
+
+    // Results of the last solve
+    double lambda = 0;                          // Fraction of every demand routed
+    std::vector<double> routed;                 // Per commodity
+    std::vector<std::vector<double>> flow;      // Per commodity, per arc (forward arcs only)
+    double cost = 0;
+
+    explicit MultiCommodityFlow(const FlowGraph &g) : graph(g) {}
+
+    // Returns lambda; routed and flow give what each commodity received,
+    // capped at its demand
+    double maxConcurrentFlow(const std::vector<Commodity> &commodities) {
+        int k = (int)commodities.size();
+        int m = 0;
+        for (int a : graph.inputArc) m += graph.capacity[a] > 0;
+        augmentations = arcScans = phases = 0;
+        routed.assign(k, 0);
+        flow.assign(k, std::vector<double>(graph.numArcs(), 0));
+        lambda = cost = 0;
+        if (k == 0 || m == 0) return 0;
+
+        // Rescale so that min over commodities of maxFlow / demand equals k
+        std::vector<double> demand(k, 0);
+        std::vector<int> residual;
+        double ratio = std::numeric_limits<double>::infinity();
+        int routable = 0;
+        for (int j = 0; j < k; j++) {
+            const Commodity &c = commodities[j];
+            if (c.demand <= 0 || c.source >= graph.numNodes || c.sink >= graph.numNodes || c.source == c.sink) continue;
+            residual.assign(graph.capacity.begin(), graph.capacity.end());
+            long long single = Dinic(graph, residual).maxFlow(c.source, c.sink);
+            if (single == 0) continue;
+            demand[j] = c.demand;
+            ratio = std::min(ratio, single / c.demand);
+            routable++;
+        }
+        if (routable == 0) return 0;
+        for (double &d : demand) d *= ratio / routable;
+
+        dist.assign(graph.numNodes, std::numeric_limits<double>::infinity());
+        parentArc.assign(graph.numNodes, -1);
+        touched.clear();
+        // delta underflows for small epsilon on large networks, so lengths
+        // are kept divided by exp(logScale), which starts at delta, and
+        // rescaled whenever their volume grows large
+        double logDelta = -std::log(m / (1 - epsilon)) / epsilon;
+        double logScale = logDelta;
+        length.assign(graph.numArcs(), 0);
+        for (int a : graph.inputArc) {
+            if (graph.capacity[a] > 0) length[a] = 1.0 / graph.capacity[a];
+        }
+        double volume = m;                          // sum(length * capacity), scaled
+        double volumeLimit = std::exp(-logScale);   // 1 in true units; may be infinite
+
+        while (volume < volumeLimit) {
+            for (int j = 0; j < k && volume < volumeLimit; j++) {
+                double remaining = demand[j];
+                bool havePath = false;
+                double pathLimit = 0;
+                while (remaining > 0 && volume < volumeLimit) {
+                    const Commodity &c = commodities[j];
+                    // Keep using the last path while it stays within (1 + epsilon)
+                    // of the shortest length it had, which the analysis allows
+                    double current = 0;
+                    if (havePath) {
+                        for (NodeId v = c.sink; v != c.source; v = graph.tail(parentArc[v])) current += length[parentArc[v]];
+                    }
+                    if (!havePath || current > pathLimit) {
+                        if (!shortestPath(c.source, c.sink)) break;
+                        havePath = true;
+                        pathLimit = (1 + epsilon) * dist[c.sink];
+                    }
+                    double amount = remaining;
+                    for (NodeId v = c.sink; v != c.source; v = graph.tail(parentArc[v])) {
+                        amount = std::min<double>(amount, graph.capacity[parentArc[v]]);
+                    }
+                    for (NodeId v = c.sink; v != c.source; v = graph.tail(parentArc[v])) {
+                        int a = parentArc[v];
+                        flow[j][a] += amount;
+                        double grown = length[a] * epsilon * amount / graph.capacity[a];
+                        length[a] += grown;
+                        volume += grown * graph.capacity[a];
+                    }
+                    remaining -= amount;
+                    augmentations++;
+                    if (volume > RESCALE_VOLUME) {
+                        rescaleLengths(volume);
+                        logScale += std::log(RESCALE_VOLUME);
+                        volumeLimit = std::exp(-logScale);
+                        pathLimit /= RESCALE_VOLUME;
+                    }
+                }
+            }
+            phases++;
+        }
+
+        // Scale into the capacities: the theoretical factor, then whatever
+        // congestion is left from the last, partial phase
+        double scale = -logDelta / std::log1p(epsilon);
+        double congestion = 0;
+        for (int a : graph.inputArc) {
+            if (graph.capacity[a] == 0) continue;
+            double total = 0;
+            for (int j = 0; j < k; j++) total += flow[j][a];
+            congestion = std::max(congestion, total / scale / graph.capacity[a]);
+        }
+        scale *= std::max(1.0, congestion);
+
+        lambda = std::numeric_limits<double>::infinity();
+        for (int j = 0; j < k; j++) {
+            if (demand[j] == 0) continue;
+            const Commodity &c = commodities[j];
+            double out = 0;
+            for (int a = graph.offset[c.source]; a < graph.offset[c.source + 1]; a++) out += flow[j][a];
+            for (int a = graph.offset[c.source]; a < graph.offset[c.source + 1]; a++) out -= flow[j][graph.reverse[a]];
+            out /= scale;
+            double keep = out > c.demand && out > 0 ? c.demand / out : 1;
+            for (double &f : flow[j]) f = f / scale * keep;
+            routed[j] = out * keep;
+            lambda = std::min(lambda, routed[j] / c.demand);
+            for (int a : graph.inputArc) cost += flow[j][a] * graph.cost[a];
+        }
+        if (lambda == std::numeric_limits<double>::infinity()) lambda = 0;
+        return lambda;
+    }
+};
+
+#endif // MULTI_COMMODITY_FLOW_HPP
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <chrono>
+#include "flow_graph.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+template <typename T>
+bool sameArray(const GraphArray<T> &a, const GraphArray<T> &b) {
+    return a.size() == b.size() && equal(a.begin(), a.end(), b.begin());
+}
+
+// Same arcs, in the same order, and the same node names
+bool sameFlowGraph(const FlowGraph &a, const FlowGraph &b) {
+    if (a.numNodes != b.numNodes || !sameArray(a.offset, b.offset) || !sameArray(a.head, b.head) ||
+        !sameArray(a.capacity, b.capacity) || !sameArray(a.cost, b.cost) || !sameArray(a.reverse, b.reverse) ||
+        !sameArray(a.inputArc, b.inputArc)) {
+        return false;
+    }
+    for (NodeId u = 0; u < a.numNodes; u++) {
+        if (a.nodeName(u) != b.nodeName(u) || b.nodeId(a.nodeName(u)) != u) return false;
+    }
+    return true;
+}
+
+// Converts a network.json file into the memory-mappable binary format
+// understood by loadFlowGraph.
+int main(int argc, char *argv[]) {
+    string input = argc > 1 ? argv[1] : "network.json";
+    string output = argc > 2 ? argv[2] : "network.bin";
+
+    auto start = steady_clock::now();
+    FlowGraph graph;
+    if (!loadFlowGraphJSON(input, graph)) {
+        cerr << "Error: failed to load " << input << endl;
+        return 1;
+    }
+    auto loaded = steady_clock::now();
+
+    if (!saveFlowGraphBinary(output, graph)) {
+        cerr << "Error: Unable to write " << output << endl;
+        return 1;
+    }
+    auto saved = steady_clock::now();
+
+    cout << "Converted " << input << " -> " << output << endl;
+    cout << "Nodes: " << graph.numNodes << " | Edges: " << graph.numEdges() << endl;
+    cout << "JSON load time: " << duration<double>(loaded - start).count() << " seconds" << endl;
+    cout << "Binary write time: " << duration<double>(saved - loaded).count() << " seconds" << endl;
+
+    // Round-trip check: the mapped file must describe the same graph
+    FlowGraph mapped;
+    auto mapStart = steady_clock::now();
+    if (!mapFlowGraphBinary(output, mapped)) {
+        cerr << "Error: " << output << " could not be mapped back" << endl;
+        return 1;
+    }
+    cout << "Binary map time: " << duration<double>(steady_clock::now() - mapStart).count() << " seconds" << endl;
+    if (!sameFlowGraph(graph, mapped)) {
+        cerr << "Error: " << output << " does not match " << input << endl;
+        return 1;
+    }
+    return 0;
+}
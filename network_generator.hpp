@@ -0,0 +1,331 @@
+#ifndef NETWORK_GENERATOR_HPP
+#define NETWORK_GENERATOR_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "flow_graph.hpp"
+
+// Counter-based random stream: every value is a pure function of
+// (seed, stream, counter), so a node's draws do not depend on which thread
+// generates it or in what order.
+class CounterRng {
+private:
+    uint64_t key;
+    uint64_t counter = 0;
+
+    static uint64_t mix(uint64_t z) { // SplitMix64 finalizer
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+public:
+    CounterRng(uint64_t seed, uint64_t stream) : key(mix(seed ^ mix(stream + 0x9E3779B97F4A7C15ULL))) {}
+
+    uint64_t next() { return mix(key + ++counter * 0x9E3779B97F4A7C15ULL); }
+
+    double unit() { return (next() >> 11) * (1.0 / 9007199254740992.0); } // [0, 1)
+
+    int range(int low, int high) { return low + (int)(next() % (uint64_t)(high - low + 1)); }
+};
+
+// A generated link. Distance and energy are only known for physical flights;
+// the super source and super sink links are virtual and cost nothing.
+struct DroneLink {
+    NodeId to;
+    int capacity;
+    int cost;
+    double distanceKm = 0, energyWh = 0;
+    bool physical = false;
+};
+
+enum class Topology {
+    FullMesh,   // Every warehouse serves every drone, every drone every destination
+    KNearest,   // Uniform random sites; each warehouse and drone links to its k nearest
+    Grid,       // Sites on a jittered geographic grid, linked to the k nearest
+};
+
+struct GeneratorOptions {
+    int numWarehouses = 2, numDrones = 2, numDestinations = 2;
+    Topology topology = Topology::FullMesh;
+    int neighbours = 4;         // k for the sparse topologies
+    double areaKm = 20.0;       // Side of the square service area
+    uint64_t seed = 1;
+    unsigned threads = 0;       // 0 uses every hardware thread
+};
+
+// Dense id layout of a generated network: Source, Sink, then warehouses,
+// drones and destinations in index order. Names are derived from ids on
+// demand, so the generator never stores them.
+struct NetworkLayout {
+    int numWarehouses = 0, numDrones = 0, numDestinations = 0;
+
+    static const NodeId SOURCE = 0, SINK = 1;
+    NodeId warehouse(int i) const { return 2 + i; }
+    NodeId drone(int j) const { return 2 + numWarehouses + j; }
+    NodeId destination(int k) const { return 2 + numWarehouses + numDrones + k; }
+    NodeId numNodes() const { return 2 + numWarehouses + numDrones + numDestinations; }
+
+    // Writes the name of u into out, reusing its storage
+    void name(NodeId u, std::string &out) const {
+        out.clear();
+        if (u == SOURCE) out += "Source";
+        else if (u == SINK) out += "Sink";
+        else if (u < drone(0)) out.append("Warehouse_").append(std::to_string(u - warehouse(0)));
+        else if (u < destination(0)) out.append("Drone_").append(std::to_string(u - drone(0)));
+        else out.append("Destination_").append(std::to_string(u - destination(0)));
+    }
+
+    std::string name(NodeId u) const {
+        std::string result;
+        name(u, result);
+        return result;
+    }
+};
+
+// Receives the generated network one source node at a time, in id order
+class NetworkSink {
+public:
+    virtual ~NetworkSink() = default;
+    virtual bool begin(const NetworkLayout &) { return true; }
+    virtual void node(NodeId from, const DroneLink *links, size_t count) = 0;
+    virtual bool end() { return true; }
+};
+
+// Builds a FlowGraph in memory from the generated network, keeping the
+// layout's node ids
+class FlowGraphSink : public NetworkSink {
+private:
+    FlowGraphBuilder builder;
+
+public:
+    bool begin(const NetworkLayout &layout) override {
+        builder = FlowGraphBuilder();
+        std::string name;
+        for (NodeId u = 0; u < layout.numNodes(); u++) {
+            layout.name(u, name);
+            builder.addNode(name);
+        }
+        return true;
+    }
+
+    void node(NodeId from, const DroneLink *links, size_t count) override {
+        for (size_t i = 0; i < count; i++) builder.addEdge(from, links[i].to, links[i].capacity, links[i].cost);
+    }
+
+    FlowGraph build() { return builder.build(); }
+};
+
+// Uniform grid over the service area for k-nearest queries
+class SpatialIndex {
+private:
+    const std::vector<float> *x = nullptr, *y = nullptr;
+    int side = 1;
+    double cellKm = 1;
+    std::vector<int> cellStart;
+    std::vector<NodeId> items;
+
+    int cellOf(double coordinate) const {
+        return std::min(side - 1, std::max(0, (int)(coordinate / cellKm)));
+    }
+
+public:
+    void build(const std::vector<float> &xs, const std::vector<float> &ys, NodeId first, int count, double areaKm) {
+        x = &xs;
+        y = &ys;
+        side = std::max(1, (int)std::sqrt(count / 2.0)); // About two sites per cell
+        cellKm = areaKm / side;
+        cellStart.assign((size_t)side * side + 1, 0);
+        items.resize(count);
+        for (int i = 0; i < count; i++) cellStart[(size_t)cellOf(ys[first + i]) * side + cellOf(xs[first + i]) + 1]++;
+        for (size_t c = 1; c < cellStart.size(); c++) cellStart[c] += cellStart[c - 1];
+        std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+        for (int i = 0; i < count; i++) {
+            NodeId u = first + i;
+            items[fill[(size_t)cellOf(ys[u]) * side + cellOf(xs[u])]++] = u;
+        }
+    }
+
+    // The k sites closest to (px, py), nearest first; ties go to the lower id
+    void nearest(double px, double py, int k, std::vector<NodeId> &out) const {
+        std::priority_queue<std::pair<double, NodeId>> best; // Max-heap of the current k
+        int cx = cellOf(px), cy = cellOf(py);
+        for (int ring = 0; ring <= side; ring++) {
+            for (int gy = cy - ring; gy <= cy + ring; gy++) {
+                if (gy < 0 || gy >= side) continue;
+                bool edgeRow = gy == cy - ring || gy == cy + ring;
+                for (int gx = cx - ring; gx <= cx + ring; gx += edgeRow ? 1 : 2 * ring) {
+                    if (gx >= 0 && gx < side) {
+                        size_t cell = (size_t)gy * side + gx;
+                        for (int i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+                            NodeId v = items[i];
+                            double dx = (*x)[v] - px, dy = (*y)[v] - py;
+                            std::pair<double, NodeId> candidate(dx * dx + dy * dy, v);
+                            if ((int)best.size() < k) best.push(candidate);
+                            else if (candidate < best.top()) {
+                                best.pop();
+                                best.push(candidate);
+                            }
+                        }
+                    }
+                    if (ring == 0) break;
+                }
+            }
+            // Anything outside this ring is at least ring cells away
+            double reach = ring * cellKm;
+            if ((int)best.size() == k && best.top().first <= reach * reach) break;
+        }
+        out.resize(best.size());
+        for (size_t i = out.size(); i-- > 0; best.pop()) out[i] = best.top().second;
+    }
+};
+
+// Multi-threaded drone network generator.
+//
+// Source nodes are processed in blocks: each worker fills one block with the
+// outgoing links of its nodes, then the blocks are handed to the sink in id
+// order. Memory stays at one block of links per thread on top of the site
+// coordinates, and the output is identical for any thread count.
+class ParallelNetworkGenerator {
+private:
+    GeneratorOptions options;
+    NetworkLayout layout;
+    std::vector<float> x, y;
+    SpatialIndex droneIndex, destinationIndex;
+
+    static const NodeId BLOCK_NODES = 4096;
+
+    // Streams per node: one for its site, one for its links
+    uint64_t siteStream(NodeId u) const { return 2 * (uint64_t)u; }
+    uint64_t linkStream(NodeId u) const { return 2 * (uint64_t)u + 1; }
+
+    void placeSites(NodeId first, int count) {
+        int side = std::max(1, (int)std::ceil(std::sqrt((double)count)));
+        double cellKm = options.areaKm / side;
+        for (int i = 0; i < count; i++) {
+            NodeId u = first + i;
+            CounterRng rng(options.seed, siteStream(u));
+            if (options.topology == Topology::Grid) {
+                x[u] = (float)((i % side + 0.25 + 0.5 * rng.unit()) * cellKm);
+                y[u] = (float)((i / side + 0.25 + 0.5 * rng.unit()) * cellKm);
+            } else {
+                x[u] = (float)(rng.unit() * options.areaKm);
+                y[u] = (float)(rng.unit() * options.areaKm);
+            }
+        }
+    }
+
+    // Energy follows the distance with up to +-20% for wind and payload, and
+    // the cost is the energy in whole Wh
+    DroneLink flight(NodeId u, NodeId v, int capacity, CounterRng &rng) const {
+        double dx = x[u] - x[v], dy = y[u] - y[v];
+        double distanceKm = std::max(0.1, std::sqrt(dx * dx + dy * dy));
+        double energyWh = distanceKm * DRONE_ENERGY_WH_PER_KM * (0.8 + 0.4 * rng.unit());
+        DroneLink link{v, capacity, std::max(1, (int)std::lround(energyWh))};
+        link.distanceKm = std::round(distanceKm * 100) / 100;
+        link.energyWh = std::round(energyWh * 10) / 10;
+        link.physical = true;
+        return link;
+    }
+
+    void generateLinks(NodeId u, std::vector<DroneLink> &out, std::vector<NodeId> &neighbours) const {
+        CounterRng rng(options.seed, linkStream(u));
+        bool sparse = options.topology != Topology::FullMesh;
+
+        if (u == NetworkLayout::SOURCE) {
+            for (int i = 0; i < layout.numWarehouses; i++) out.push_back({layout.warehouse(i), rng.range(5, 15), 0});
+        } else if (u == NetworkLayout::SINK) {
+            return;
+        } else if (u < layout.drone(0)) {
+            if (sparse) droneIndex.nearest(x[u], y[u], options.neighbours, neighbours);
+            int count = sparse ? (int)neighbours.size() : layout.numDrones;
+            for (int j = 0; j < count; j++) {
+                out.push_back(flight(u, sparse ? neighbours[j] : layout.drone(j), rng.range(2, 10), rng));
+            }
+        } else if (u < layout.destination(0)) {
+            if (sparse) destinationIndex.nearest(x[u], y[u], options.neighbours, neighbours);
+            int count = sparse ? (int)neighbours.size() : layout.numDestinations;
+            for (int k = 0; k < count; k++) {
+                out.push_back(flight(u, sparse ? neighbours[k] : layout.destination(k), rng.range(1, 5), rng));
+            }
+        } else {
+            out.push_back({NetworkLayout::SINK, rng.range(5, 10), 0});
+        }
+    }
+
+    // Links of [first, last) back to back, with end[i] closing node first + i
+    struct Block {
+        std::vector<DroneLink> links;
+        std::vector<size_t> end;
+        std::vector<NodeId> neighbours;
+    };
+
+    void generateBlock(NodeId first, NodeId last, Block &block) const {
+        block.links.clear();
+        block.end.clear();
+        for (NodeId u = first; u < last; u++) {
+            generateLinks(u, block.links, block.neighbours);
+            block.end.push_back(block.links.size());
+        }
+    }
+
+public:
+    explicit ParallelNetworkGenerator(const GeneratorOptions &opts) : options(opts) {
+        options.neighbours = std::max(1, options.neighbours);
+        if (options.threads == 0) options.threads = std::max(1u, std::thread::hardware_concurrency());
+        layout.numWarehouses = options.numWarehouses;
+        layout.numDrones = options.numDrones;
+        layout.numDestinations = options.numDestinations;
+    }
+
+    const NetworkLayout &networkLayout() const { return layout; }
+
+    bool generate(NetworkSink &sink) {
+        NodeId n = layout.numNodes();
+        x.assign(n, 0);
+        y.assign(n, 0);
+        placeSites(layout.warehouse(0), layout.numWarehouses);
+        placeSites(layout.drone(0), layout.numDrones);
+        placeSites(layout.destination(0), layout.numDestinations);
+        if (options.topology != Topology::FullMesh) {
+            droneIndex.build(x, y, layout.drone(0), layout.numDrones, options.areaKm);
+            destinationIndex.build(x, y, layout.destination(0), layout.numDestinations, options.areaKm);
+        }
+
+        if (!sink.begin(layout)) return false;
+
+        unsigned numThreads = options.threads;
+        std::vector<Block> blocks(numThreads);
+        for (NodeId first = 0; first < n; first += BLOCK_NODES * numThreads) {
+            std::vector<std::thread> workers;
+            for (unsigned t = 1; t < numThreads; t++) {
+                NodeId blockFirst = first + t * BLOCK_NODES;
+                if (blockFirst >= n) break;
+                workers.emplace_back([this, blockFirst, n, &blocks, t] {
+                    generateBlock(blockFirst, std::min(n, blockFirst + BLOCK_NODES), blocks[t]);
+                });
+            }
+            generateBlock(first, std::min(n, first + BLOCK_NODES), blocks[0]);
+            for (auto &worker : workers) worker.join();
+
+            for (unsigned t = 0; t < numThreads; t++) {
+                NodeId blockFirst = first + t * BLOCK_NODES;
+                if (blockFirst >= n) break;
+                const Block &block = blocks[t];
+                for (size_t i = 0; i < block.end.size(); i++) {
+                    size_t begin = i == 0 ? 0 : block.end[i - 1];
+                    if (block.end[i] > begin) sink.node(blockFirst + (NodeId)i, block.links.data() + begin, block.end[i] - begin);
+                }
+            }
+        }
+        return sink.end();
+    }
+};
+
+#endif // NETWORK_GENERATOR_HPP
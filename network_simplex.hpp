@@ -0,0 +1,375 @@
+#ifndef NETWORK_SIMPLEX_HPP
+#define NETWORK_SIMPLEX_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "flow_graph.hpp"
+#include "push_relabel.hpp"
+
+// One s-t path of a flow decomposition: nodes from source to sink and the
+// number of units routed along them.
+struct FlowPath {
+    int amount;
+    std::vector<NodeId> nodes;
+};
+
+// Primal network simplex min-cost max flow on a FlowGraph.
+//
+// The maximum flow value F is found first with push-relabel; network simplex
+// then routes F units from source to sink at minimum cost. The basis is a
+// spanning tree rooted at an artificial node with one artificial arc per node,
+// kept strongly feasible (every zero-flow tree arc points away from the root)
+// by always leaving through the last blocking arc of the pivot cycle, which
+// rules out cycling on degenerate pivots. Entering arcs are chosen by block
+// search: arcs are scanned in blocks of about sqrt(m) and the most violating
+// arc of the first block that has one enters.
+//
+// The tree is stored as parent/pred arrays with child lists; a pivot only
+// re-roots and re-prices the subtree that moves.
+class NetworkSimplex {
+private:
+    enum ArcState : signed char { STATE_UPPER = -1, STATE_TREE = 0, STATE_LOWER = 1 };
+
+    const FlowGraph &graph;
+    std::vector<int> &residual;
+    int n, m, root;
+
+    // Real arcs [0, m) follow the input edge order, artificial arc m + u joins u to the root
+    std::vector<int> source, target;
+    std::vector<long long> capacity, cost, flow;
+    std::vector<signed char> state;
+
+    std::vector<int> parent, pred, depth;
+    std::vector<char> predUp; // pred[u] is directed u -> parent[u]
+    std::vector<long long> pi;
+    std::vector<int> firstChild, nextSibling, prevSibling;
+    std::vector<int> subtreeStack;
+
+    int blockSize = 0, nextArc = 0;
+    int inArc = -1, join = -1, uOut = -1;
+    long long delta = 0;
+
+    void addChild(int p, int c) {
+        prevSibling[c] = -1;
+        nextSibling[c] = firstChild[p];
+        if (firstChild[p] != -1) prevSibling[firstChild[p]] = c;
+        firstChild[p] = c;
+    }
+
+    void removeChild(int p, int c) {
+        if (prevSibling[c] != -1) nextSibling[prevSibling[c]] = nextSibling[c];
+        else firstChild[p] = nextSibling[c];
+        if (nextSibling[c] != -1) prevSibling[nextSibling[c]] = prevSibling[c];
+    }
+
+    void init(NodeId s, NodeId t, long long supply) {
+        const long long INF = std::numeric_limits<long long>::max() / 4;
+        int arcs = m + n;
+        source.resize(arcs);
+        target.resize(arcs);
+        capacity.resize(arcs);
+        cost.resize(arcs);
+        flow.assign(arcs, 0);
+        state.assign(arcs, STATE_LOWER);
+
+        long long maxCost = 0;
+        for (int i = 0; i < m; i++) {
+            int a = graph.inputArc[i];
+            source[i] = graph.tail(a);
+            target[i] = graph.head[a];
+            capacity[i] = graph.capacity[a];
+            cost[i] = graph.cost[a];
+            maxCost = std::max(maxCost, std::abs(cost[i]));
+        }
+        // Costlier than any simple path, so artificial arcs end up empty
+        long long artificialCost = (maxCost + 1) * (n + 1);
+
+        parent.assign(n + 1, -1);
+        pred.assign(n + 1, -1);
+        depth.assign(n + 1, 0);
+        predUp.assign(n + 1, false);
+        pi.assign(n + 1, 0);
+        firstChild.assign(n + 1, -1);
+        nextSibling.assign(n + 1, -1);
+        prevSibling.assign(n + 1, -1);
+
+        for (int u = 0; u < n; u++) {
+            int e = m + u;
+            long long b = (u == (int)s) ? supply : (u == (int)t) ? -supply : 0;
+            capacity[e] = INF;
+            state[e] = STATE_TREE;
+            parent[u] = root;
+            pred[u] = e;
+            depth[u] = 1;
+            if (b > 0) {
+                source[e] = u;
+                target[e] = root;
+                cost[e] = 0;
+                flow[e] = b;
+                predUp[u] = true;
+                pi[u] = 0;
+            } else {
+                source[e] = root;
+                target[e] = u;
+                cost[e] = artificialCost;
+                flow[e] = -b;
+                predUp[u] = false;
+                pi[u] = artificialCost;
+            }
+            addChild(root, u);
+        }
+
+        blockSize = std::max(10, (int)std::sqrt((double)m));
+        nextArc = 0;
+    }
+
+    long long violation(int e) const {
+        return state[e] * (cost[e] + pi[source[e]] - pi[target[e]]);
+    }
+
+    bool findEnteringArc() {
+        long long best = 0;
+        int bestArc = -1, count = blockSize;
+        for (int step = 0; step < m; step++) {
+            int e = nextArc + step < m ? nextArc + step : nextArc + step - m;
+            long long c = violation(e);
+            if (c < best) {
+                best = c;
+                bestArc = e;
+            }
+            if (--count == 0) {
+                if (best < 0) {
+                    inArc = bestArc;
+                    nextArc = e + 1 < m ? e + 1 : 0;
+                    arcScans += step + 1;
+                    return true;
+                }
+                count = blockSize;
+            }
+        }
+        arcScans += m;
+        if (best < 0) {
+            inArc = bestArc;
+            return true;
+        }
+        return false;
+    }
+
+    void findJoinNode() {
+        int u = source[inArc], v = target[inArc];
+        while (u != v) {
+            if (depth[u] > depth[v]) u = parent[u];
+            else if (depth[v] > depth[u]) v = parent[v];
+            else {
+                u = parent[u];
+                v = parent[v];
+            }
+        }
+        join = u;
+    }
+
+    // Returns 0 if the entering arc itself blocks, 1 or 2 for the side of the
+    // cycle holding the leaving arc (pred[uOut])
+    int findLeavingArc() {
+        int first, second;
+        if (state[inArc] == STATE_LOWER) {
+            first = source[inArc];
+            second = target[inArc];
+        } else {
+            first = target[inArc];
+            second = source[inArc];
+        }
+        delta = capacity[inArc];
+        int result = 0;
+
+        for (int u = first; u != join; u = parent[u]) {
+            int e = pred[u];
+            long long d = predUp[u] ? flow[e] : capacity[e] - flow[e];
+            if (d < delta) {
+                delta = d;
+                uOut = u;
+                result = 1;
+            }
+        }
+        for (int u = second; u != join; u = parent[u]) {
+            int e = pred[u];
+            long long d = predUp[u] ? capacity[e] - flow[e] : flow[e];
+            if (d <= delta) {
+                delta = d;
+                uOut = u;
+                result = 2;
+            }
+        }
+        return result;
+    }
+
+    void changeFlow() {
+        if (delta == 0) return;
+        long long val = state[inArc] * delta;
+        flow[inArc] += val;
+        for (int u = source[inArc]; u != join; u = parent[u]) flow[pred[u]] += predUp[u] ? -val : val;
+        for (int u = target[inArc]; u != join; u = parent[u]) flow[pred[u]] += predUp[u] ? val : -val;
+    }
+
+    // Hang the subtree of uOut from the entering arc, re-rooted at newRoot
+    void updateTree(int newRoot, int attachTo) {
+        int leaving = pred[uOut];
+        state[leaving] = flow[leaving] == 0 ? STATE_LOWER : STATE_UPPER;
+        state[inArc] = STATE_TREE;
+
+        int prevNode = attachTo, prevArc = inArc;
+        bool prevUp = source[inArc] == newRoot;
+        int w = newRoot;
+        while (true) {
+            int oldParent = parent[w], oldArc = pred[w];
+            bool oldUp = predUp[w];
+            removeChild(oldParent, w);
+            parent[w] = prevNode;
+            pred[w] = prevArc;
+            predUp[w] = prevUp;
+            addChild(prevNode, w);
+            if (w == uOut) break;
+            prevNode = w;
+            prevArc = oldArc;
+            prevUp = !oldUp;
+            w = oldParent;
+        }
+
+        // Depths and potentials change only inside the moved subtree
+        subtreeStack.assign(1, newRoot);
+        while (!subtreeStack.empty()) {
+            int u = subtreeStack.back();
+            subtreeStack.pop_back();
+            int p = parent[u];
+            depth[u] = depth[p] + 1;
+            pi[u] = predUp[u] ? pi[p] - cost[pred[u]] : pi[p] + cost[pred[u]];
+            for (int c = firstChild[u]; c != -1; c = nextSibling[c]) subtreeStack.push_back(c);
+        }
+    }
+
+public:
+    // Work done by the last solve; arcScans includes the push-relabel pass
+    long long pivots = 0, degeneratePivots = 0, arcScans = 0;
+
+    NetworkSimplex(const FlowGraph &g, std::vector<int> &residualCapacity)
+        : graph(g), residual(residualCapacity), n(g.numNodes), m(g.numEdges()), root(g.numNodes) {}
+
+    // Solves from the graph's capacities (ignoring the residual array's
+    // current contents) and leaves the optimal flow in the residual array.
+    // Returns (flow, cost) in the same form as MinCostMaxFlow::minCostMaxFlow.
+    std::pair<int, int> minCostMaxFlow(NodeId s, NodeId t) {
+        pivots = degeneratePivots = 0;
+
+        residual.assign(graph.capacity.begin(), graph.capacity.end());
+        PushRelabel maxFlowSolver(graph, residual);
+        long long flowValue = s == t ? 0 : maxFlowSolver.maxFlow(s, t);
+        arcScans = maxFlowSolver.arcScans;
+
+        init(s, t, flowValue);
+        while (findEnteringArc()) {
+            findJoinNode();
+            int side = findLeavingArc();
+            changeFlow();
+            pivots++;
+            if (delta == 0) degeneratePivots++;
+
+            if (side == 0) {
+                state[inArc] = (signed char)-state[inArc];
+            } else {
+                int first = state[inArc] == STATE_LOWER ? source[inArc] : target[inArc];
+                int second = state[inArc] == STATE_LOWER ? target[inArc] : source[inArc];
+                if (side == 1) updateTree(first, second);
+                else updateTree(second, first);
+            }
+        }
+
+        long long totalCost = 0;
+        residual.assign(graph.capacity.begin(), graph.capacity.end());
+        for (int i = 0; i < m; i++) {
+            int a = graph.inputArc[i];
+            residual[a] -= (int)flow[i];
+            residual[graph.reverse[a]] += (int)flow[i];
+            totalCost += flow[i] * cost[i];
+        }
+        return std::make_pair((int)flowValue, (int)totalCost);
+    }
+
+    // Split the optimal flow into source-sink paths. Zero-cost cycles that an
+    // optimal flow may still carry are cancelled rather than reported.
+    std::vector<FlowPath> decompose(NodeId s, NodeId t) const {
+        std::vector<FlowPath> paths;
+        std::vector<long long> remaining(flow.begin(), flow.begin() + m);
+        std::vector<int> edgeOfArc(graph.numArcs(), -1);
+        for (int i = 0; i < m; i++) edgeOfArc[graph.inputArc[i]] = i;
+
+        std::vector<int> currentArc(graph.offset.begin(), graph.offset.end() - 1);
+        std::vector<int> pathEdges;
+        std::vector<int> positionOnPath(n, -1);
+
+        auto nextEdge = [&](NodeId u) {
+            for (int &a = currentArc[u]; a < graph.offset[u + 1]; a++) {
+                int e = edgeOfArc[a];
+                if (e != -1 && remaining[e] > 0) return e;
+            }
+            return -1;
+        };
+
+        if (s == t) return paths;
+        while (true) {
+            pathEdges.clear();
+            NodeId u = s;
+            positionOnPath[s] = 0;
+            bool reachedSink = false;
+
+            while (true) {
+                if (u == t) {
+                    reachedSink = true;
+                    break;
+                }
+                int e = nextEdge(u);
+                if (e == -1) break;
+
+                NodeId v = target[e];
+                if (positionOnPath[v] != -1) {
+                    // Cancel the cycle closing at v and retry from there
+                    int start = positionOnPath[v];
+                    long long amount = remaining[e];
+                    for (size_t i = start; i < pathEdges.size(); i++) amount = std::min(amount, remaining[pathEdges[i]]);
+                    remaining[e] -= amount;
+                    for (size_t i = start; i < pathEdges.size(); i++) {
+                        remaining[pathEdges[i]] -= amount;
+                        positionOnPath[target[pathEdges[i]]] = -1;
+                    }
+                    pathEdges.resize(start);
+                    u = v;
+                    continue;
+                }
+                positionOnPath[v] = (int)pathEdges.size() + 1;
+                pathEdges.push_back(e);
+                u = v;
+            }
+
+            positionOnPath[s] = -1;
+            for (int e : pathEdges) positionOnPath[target[e]] = -1;
+            if (!reachedSink) break;
+
+            long long amount = std::numeric_limits<long long>::max();
+            for (int e : pathEdges) amount = std::min(amount, remaining[e]);
+            FlowPath path;
+            path.amount = (int)amount;
+            path.nodes.push_back(s);
+            for (int e : pathEdges) {
+                remaining[e] -= amount;
+                path.nodes.push_back(target[e]);
+            }
+            paths.push_back(std::move(path));
+        }
+        return paths;
+    }
+};
+
+#endif // NETWORK_SIMPLEX_HPP
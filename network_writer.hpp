@@ -0,0 +1,285 @@
+#ifndef NETWORK_WRITER_HPP
+#define NETWORK_WRITER_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "flow_graph.hpp"
+#include "network_generator.hpp"
+
+// Output file with one large buffer, written with a single fwrite whenever it
+// fills. Numbers are formatted in place with to_chars.
+class BufferedWriter {
+private:
+    FILE *file = nullptr;
+    std::vector<char> buffer;
+    size_t used = 0;
+    bool failed = false;
+
+    void flush() {
+        if (used > 0 && std::fwrite(buffer.data(), 1, used, file) != used) failed = true;
+        used = 0;
+    }
+
+    char *reserve(size_t bytes) {
+        if (used + bytes > buffer.size()) flush();
+        return buffer.data() + used;
+    }
+
+public:
+    static const size_t DEFAULT_BUFFER_BYTES = 8 << 20;
+
+    BufferedWriter() {}
+    BufferedWriter(const BufferedWriter &) = delete;
+    BufferedWriter &operator=(const BufferedWriter &) = delete;
+    ~BufferedWriter() { close(); }
+
+    bool open(const std::string &filename, size_t bufferBytes = DEFAULT_BUFFER_BYTES) {
+        close();
+        file = std::fopen(filename.c_str(), "wb");
+        if (!file) return false;
+        buffer.resize(std::max<size_t>(bufferBytes, 64));
+        failed = false;
+        return true;
+    }
+
+    void put(char c) {
+        *reserve(1) = c;
+        used++;
+    }
+
+    void put(std::string_view text) {
+        if (text.size() > buffer.size()) {
+            flush();
+            if (std::fwrite(text.data(), 1, text.size(), file) != text.size()) failed = true;
+            return;
+        }
+        std::memcpy(reserve(text.size()), text.data(), text.size());
+        used += text.size();
+    }
+
+    void putInt(long long value) {
+        char *out = reserve(24);
+        used = std::to_chars(out, out + 24, value).ptr - buffer.data();
+    }
+
+    // Shortest representation that reads back as the same double
+    void putDouble(double value) {
+        char *out = reserve(32);
+        used = std::to_chars(out, out + 32, value).ptr - buffer.data();
+    }
+
+    // Returns false if any write failed
+    bool close() {
+        if (!file) return !failed;
+        flush();
+        if (std::fclose(file) != 0) failed = true;
+        file = nullptr;
+        std::vector<char>().swap(buffer);
+        return !failed;
+    }
+};
+
+// Streams a network.json document node by node. Pretty output matches the
+// 4-space layout the generator always wrote; compact output has no
+// whitespace at all.
+class JsonNetworkWriter {
+private:
+    BufferedWriter out;
+    bool compact = false;
+    bool firstNode = true, firstEdge = true;
+
+    void newline(int indent) {
+        if (compact) return;
+        out.put('\n');
+        for (int i = 0; i < indent; i++) out.put("    ");
+    }
+
+    void putString(std::string_view text) {
+        out.put('"');
+        size_t start = 0;
+        for (size_t i = 0; i < text.size(); i++) {
+            unsigned char c = text[i];
+            if (c != '"' && c != '\\' && c >= 0x20) continue;
+            out.put(text.substr(start, i - start));
+            if (c == '"' || c == '\\') {
+                out.put('\\');
+                out.put((char)c);
+            } else {
+                const char *hex = "0123456789abcdef";
+                out.put("\\u00");
+                out.put(hex[c >> 4]);
+                out.put(hex[c & 15]);
+            }
+            start = i + 1;
+        }
+        out.put(text.substr(start));
+        out.put('"');
+    }
+
+    void putKey(std::string_view key) {
+        putString(key);
+        out.put(compact ? ":" : ": ");
+    }
+
+public:
+    bool open(const std::string &filename, bool compactOutput = false) {
+        if (!out.open(filename)) return false;
+        compact = compactOutput;
+        firstNode = true;
+        out.put('{');
+        return true;
+    }
+
+    void beginNode(std::string_view name) {
+        if (!firstNode) out.put(',');
+        firstNode = false;
+        firstEdge = true;
+        newline(1);
+        putKey(name);
+        out.put('[');
+    }
+
+    void edge(std::string_view destination, const DroneLink &link) {
+        if (!firstEdge) out.put(',');
+        firstEdge = false;
+        newline(2);
+        out.put('{');
+        newline(3);
+        putKey("destination");
+        putString(destination);
+        out.put(',');
+        newline(3);
+        putKey("capacity");
+        out.putInt(link.capacity);
+        out.put(',');
+        newline(3);
+        putKey("cost");
+        out.putInt(link.cost);
+        if (link.physical) {
+            out.put(',');
+            newline(3);
+            putKey("distance_km");
+            out.putDouble(link.distanceKm);
+            out.put(',');
+            newline(3);
+            putKey("energy_wh");
+            out.putDouble(link.energyWh);
+        }
+        newline(2);
+        out.put('}');
+    }
+
+    void endNode() {
+        newline(1);
+        out.put(']');
+    }
+
+    bool close() {
+        newline(0);
+        out.put('}');
+        if (!compact) out.put('\n');
+        return out.close();
+    }
+};
+
+// Generator sink writing network.json as the nodes arrive
+class JsonNetworkSink : public NetworkSink {
+private:
+    JsonNetworkWriter writer;
+    std::string filename;
+    bool compact;
+    const NetworkLayout *layout = nullptr;
+    std::string fromName, toName;
+
+public:
+    size_t edgesWritten = 0;
+
+    JsonNetworkSink(const std::string &file, bool compactOutput) : filename(file), compact(compactOutput) {}
+
+    bool begin(const NetworkLayout &networkLayout) override {
+        layout = &networkLayout;
+        edgesWritten = 0;
+        return writer.open(filename, compact);
+    }
+
+    void node(NodeId from, const DroneLink *links, size_t count) override {
+        layout->name(from, fromName);
+        writer.beginNode(fromName);
+        for (size_t i = 0; i < count; i++) {
+            layout->name(links[i].to, toName);
+            writer.edge(toName, links[i]);
+        }
+        writer.endNode();
+        edgesWritten += count;
+    }
+
+    bool end() override { return writer.close(); }
+};
+
+// First binary pass: counts the arcs of every node
+class ArcCountSink : public NetworkSink {
+public:
+    std::vector<int> arcsPerNode;
+    uint64_t numEdges = 0;
+
+    bool begin(const NetworkLayout &layout) override {
+        arcsPerNode.assign(layout.numNodes(), 0);
+        numEdges = 0;
+        return true;
+    }
+
+    void node(NodeId from, const DroneLink *links, size_t count) override {
+        arcsPerNode[from] += (int)count;
+        for (size_t i = 0; i < count; i++) arcsPerNode[links[i].to]++;
+        numEdges += count;
+    }
+};
+
+// Second binary pass: writes the arcs into the mapped file
+class BinaryNetworkSink : public NetworkSink {
+private:
+    FlowGraphFileWriter &writer;
+
+public:
+    explicit BinaryNetworkSink(FlowGraphFileWriter &fileWriter) : writer(fileWriter) {}
+
+    void node(NodeId from, const DroneLink *links, size_t count) override {
+        for (size_t i = 0; i < count; i++) writer.addEdge(from, links[i].to, links[i].capacity, links[i].cost);
+    }
+};
+
+// Generate straight into the binary format. The generator is deterministic,
+// so it runs twice: once to size every node's arc range, once to fill it.
+// Memory stays at a few words per node whatever the number of arcs.
+inline bool writeBinaryNetwork(ParallelNetworkGenerator &generator, const std::string &filename, uint64_t &numEdges) {
+    ArcCountSink counter;
+    if (!generator.generate(counter)) return false;
+    numEdges = counter.numEdges;
+
+    const NetworkLayout &layout = generator.networkLayout();
+    std::string name;
+    uint64_t nameBytes = 0;
+    for (NodeId u = 0; u < layout.numNodes(); u++) {
+        layout.name(u, name);
+        nameBytes += name.size();
+    }
+
+    FlowGraphFileWriter writer;
+    if (!writer.create(filename, counter.arcsPerNode, counter.numEdges, nameBytes)) return false;
+    std::vector<int>().swap(counter.arcsPerNode);
+
+    BinaryNetworkSink sink(writer);
+    if (!generator.generate(sink)) return false;
+    for (NodeId u = 0; u < layout.numNodes(); u++) {
+        layout.name(u, name);
+        writer.addName(name);
+    }
+    return writer.finish();
+}
+
+#endif // NETWORK_WRITER_HPP
@@ -0,0 +1,87 @@
+#ifndef NODE_INTERNER_HPP
+#define NODE_INTERNER_HPP
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Dense node id used by every solver; names are only looked up at load time
+// and resolved back when printing results.
+using NodeId = uint32_t;
+const NodeId INVALID_NODE = UINT32_MAX;
+
+// String interner mapping node names to dense NodeIds in first-seen order.
+//
+// All names live back to back in one character buffer, and the lookup table
+// is an open-addressing array of ids probed linearly, so interning a name
+// that already exists allocates nothing and a new name costs one append.
+class NodeInterner {
+private:
+    std::vector<char> chars;              // Name of id i is chars[offsets[i], offsets[i + 1])
+    std::vector<uint32_t> offsets{0};
+    std::vector<NodeId> slots;            // Hash table of ids, INVALID_NODE when empty
+
+    static uint64_t hash(std::string_view name) {
+        uint64_t h = 14695981039346656037ULL; // FNV-1a
+        for (unsigned char c : name) {
+            h ^= c;
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    size_t findSlot(std::string_view name) const {
+        size_t mask = slots.size() - 1;
+        size_t slot = hash(name) & mask;
+        while (slots[slot] != INVALID_NODE && this->name(slots[slot]) != name) slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void grow() {
+        std::vector<NodeId> old = std::move(slots);
+        slots.assign(old.empty() ? 64 : old.size() * 2, INVALID_NODE);
+        for (NodeId id : old) {
+            if (id != INVALID_NODE) slots[findSlot(name(id))] = id;
+        }
+    }
+
+public:
+    NodeId intern(std::string_view name) {
+        if (2 * (size() + 1) > slots.size()) grow();
+        size_t slot = findSlot(name);
+        if (slots[slot] != INVALID_NODE) return slots[slot];
+
+        NodeId id = (NodeId)size();
+        chars.insert(chars.end(), name.begin(), name.end());
+        offsets.push_back((uint32_t)chars.size());
+        slots[slot] = id;
+        return id;
+    }
+
+    NodeId find(std::string_view name) const {
+        if (slots.empty()) return INVALID_NODE;
+        return slots[findSlot(name)];
+    }
+
+    std::string_view name(NodeId id) const {
+        return std::string_view(chars.data() + offsets[id], offsets[id + 1] - offsets[id]);
+    }
+
+    size_t size() const { return offsets.size() - 1; }
+
+    void reserve(size_t numNames, size_t numChars) {
+        chars.reserve(numChars);
+        offsets.reserve(numNames + 1);
+    }
+
+    // Hand the name storage over (e.g. to a FlowGraph) and reset the interner
+    void release(std::vector<char> &nameData, std::vector<uint32_t> &nameOffset) {
+        nameData = std::move(chars);
+        nameOffset = std::move(offsets);
+        chars.clear();
+        offsets.assign(1, 0);
+        slots.clear();
+    }
+};
+
+#endif // NODE_INTERNER_HPP
@@ -0,0 +1,265 @@
+#ifndef PUSH_RELABEL_HPP
+#define PUSH_RELABEL_HPP
+
+#include <algorithm>
+#include <queue>
+#include <vector>
+#include "flow_graph.hpp"
+
+// Highest-label push-relabel max flow on a FlowGraph.
+//
+// Phase one computes a maximum preflow: active nodes are kept in buckets by
+// label and the highest one is always discharged first. Labels are refreshed
+// by a reverse BFS from the sink every time the relabel work since the last
+// refresh exceeds O(n + m), and the gap heuristic lifts every node above an
+// emptied label straight to n, since none of them can reach the sink anymore.
+// Phase two returns the excess left on those nodes to the source so the
+// residual capacities describe a valid flow.
+class PushRelabel {
+private:
+    const FlowGraph &graph;
+    std::vector<int> &residual;
+    int n;
+    NodeId source, sink;
+
+    std::vector<int> height, currentArc;
+    std::vector<long long> excess;
+
+    // Active nodes per label, and a doubly linked list of every node per label
+    // (used by the gap heuristic). Only labels below n are bucketed.
+    std::vector<std::vector<NodeId>> active;
+    std::vector<NodeId> firstAt, nextAt, prevAt;
+    int highestActive = 0, highestLabel = 0;
+    long long relabelWork = 0;
+
+    void linkNode(NodeId v) {
+        int h = height[v];
+        prevAt[v] = INVALID_NODE;
+        nextAt[v] = firstAt[h];
+        if (firstAt[h] != INVALID_NODE) prevAt[firstAt[h]] = v;
+        firstAt[h] = v;
+        highestLabel = std::max(highestLabel, h);
+    }
+
+    void unlinkNode(NodeId v) {
+        int h = height[v];
+        if (prevAt[v] != INVALID_NODE) nextAt[prevAt[v]] = nextAt[v];
+        else firstAt[h] = nextAt[v];
+        if (nextAt[v] != INVALID_NODE) prevAt[nextAt[v]] = prevAt[v];
+    }
+
+    void activate(NodeId v) {
+        if (v == source || v == sink || height[v] >= n) return;
+        active[height[v]].push_back(v);
+        highestActive = std::max(highestActive, height[v]);
+    }
+
+    void globalRelabel() {
+        relabelWork = 0;
+        std::fill(height.begin(), height.end(), n);
+        std::fill(firstAt.begin(), firstAt.end(), INVALID_NODE);
+        for (auto &bucket : active) bucket.clear();
+        highestActive = highestLabel = 0;
+
+        std::queue<NodeId> q;
+        height[sink] = 0;
+        q.push(sink);
+        while (!q.empty()) {
+            NodeId u = q.front();
+            q.pop();
+            arcScans += graph.offset[u + 1] - graph.offset[u];
+            for (int a = graph.offset[u]; a < graph.offset[u + 1]; a++) {
+                NodeId v = graph.head[a];
+                if (height[v] == n && v != source && residual[graph.reverse[a]] > 0) {
+                    height[v] = height[u] + 1;
+                    q.push(v);
+                }
+            }
+        }
+
+        for (NodeId v = 0; v < graph.numNodes; v++) {
+            currentArc[v] = graph.offset[v];
+            if (height[v] < n && v != sink) {
+                linkNode(v);
+                if (excess[v] > 0) activate(v);
+            }
+        }
+    }
+
+    // Every node above the emptied label h is cut off from the sink
+    void gap(int h) {
+        for (int label = h + 1; label <= highestLabel; label++) {
+            for (NodeId v = firstAt[label]; v != INVALID_NODE; v = nextAt[v]) height[v] = n;
+            firstAt[label] = INVALID_NODE;
+            active[label].clear();
+        }
+        highestLabel = h - 1;
+    }
+
+    void push(NodeId u, int a, long long amount) {
+        NodeId v = graph.head[a];
+        residual[a] -= (int)amount;
+        residual[graph.reverse[a]] += (int)amount;
+        excess[u] -= amount;
+        if (excess[v] == 0) activate(v);
+        excess[v] += amount;
+        pushes++;
+    }
+
+    // Returns the new label of u, or n if u was lifted out of phase one
+    int relabel(NodeId u) {
+        int newHeight = 2 * n;
+        relabelWork += graph.offset[u + 1] - graph.offset[u] + 12;
+        arcScans += graph.offset[u + 1] - graph.offset[u];
+        for (int a = graph.offset[u]; a < graph.offset[u + 1]; a++) {
+            if (residual[a] > 0) newHeight = std::min(newHeight, height[graph.head[a]] + 1);
+        }
+        currentArc[u] = graph.offset[u];
+        return newHeight;
+    }
+
+    void discharge(NodeId u) {
+        while (excess[u] > 0) {
+            int end = graph.offset[u + 1];
+            int &a = currentArc[u];
+            for (; a < end && excess[u] > 0; a++) {
+                arcScans++;
+                NodeId v = graph.head[a];
+                if (residual[a] > 0 && height[u] == height[v] + 1) {
+                    push(u, a, std::min<long long>(excess[u], residual[a]));
+                    if (excess[u] == 0) break;
+                }
+            }
+            if (excess[u] == 0) break;
+
+            int oldHeight = height[u];
+            unlinkNode(u);
+            int newHeight = relabel(u);
+            if (firstAt[oldHeight] == INVALID_NODE) {
+                height[u] = n;
+                gap(oldHeight);
+                return;
+            }
+            if (newHeight >= n) {
+                height[u] = n;
+                return;
+            }
+            height[u] = newHeight;
+            linkNode(u);
+        }
+    }
+
+    // Push the excess stranded on nodes at label n back to the source,
+    // discharging FIFO with labels measured as distance to the source
+    void returnExcessToSource() {
+        std::vector<int> dist(n, -1);
+        std::queue<NodeId> q;
+        dist[source] = 0;
+        q.push(source);
+        while (!q.empty()) {
+            NodeId u = q.front();
+            q.pop();
+            arcScans += graph.offset[u + 1] - graph.offset[u];
+            for (int a = graph.offset[u]; a < graph.offset[u + 1]; a++) {
+                NodeId v = graph.head[a];
+                if (dist[v] == -1 && v != sink && residual[graph.reverse[a]] > 0) {
+                    dist[v] = dist[u] + 1;
+                    q.push(v);
+                }
+            }
+        }
+
+        std::queue<NodeId> pending;
+        for (NodeId v = 0; v < graph.numNodes; v++) {
+            height[v] = dist[v] == -1 ? 2 * n : dist[v];
+            currentArc[v] = graph.offset[v];
+            if (v != source && v != sink && excess[v] > 0) pending.push(v);
+        }
+
+        while (!pending.empty()) {
+            NodeId u = pending.front();
+            pending.pop();
+            while (excess[u] > 0) {
+                int &a = currentArc[u];
+                if (a == graph.offset[u + 1]) {
+                    height[u] = relabel(u);
+                    continue;
+                }
+                NodeId v = graph.head[a];
+                arcScans++;
+                if (v != sink && residual[a] > 0 && height[u] == height[v] + 1) {
+                    long long amount = std::min<long long>(excess[u], residual[a]);
+                    bool wasIdle = excess[v] == 0;
+                    residual[a] -= (int)amount;
+                    residual[graph.reverse[a]] += (int)amount;
+                    excess[u] -= amount;
+                    excess[v] += amount;
+                    pushes++;
+                    if (wasIdle && v != source) pending.push(v);
+                } else {
+                    a++;
+                }
+            }
+        }
+    }
+
+public:
+    // Work done by the last solve
+    long long discharges = 0, globalRelabels = 0, pushes = 0, arcScans = 0;
+
+    PushRelabel(const FlowGraph &g, std::vector<int> &residualCapacity)
+        : graph(g), residual(residualCapacity), n(g.numNodes) {}
+
+    // Solves from the current residual capacities and returns the flow value
+    long long maxFlow(NodeId s, NodeId t) {
+        source = s;
+        sink = t;
+        discharges = globalRelabels = pushes = arcScans = 0;
+        if (s == t) return 0;
+
+        height.assign(n, 0);
+        currentArc.assign(graph.offset.begin(), graph.offset.end() - 1);
+        excess.assign(n, 0);
+        active.assign(n, {});
+        firstAt.assign(n + 1, INVALID_NODE);
+        nextAt.assign(n, INVALID_NODE);
+        prevAt.assign(n, INVALID_NODE);
+
+        // Saturate every arc out of the source
+        for (int a = graph.offset[source]; a < graph.offset[source + 1]; a++) {
+            int amount = residual[a];
+            if (amount == 0) continue;
+            residual[a] = 0;
+            residual[graph.reverse[a]] += amount;
+            excess[graph.head[a]] += amount;
+            excess[source] -= amount;
+        }
+
+        globalRelabel();
+        globalRelabels++;
+        long long relabelLimit = 6LL * n + graph.numArcs();
+
+        while (true) {
+            while (highestActive >= 0 && active[highestActive].empty()) highestActive--;
+            if (highestActive < 0) break;
+
+            NodeId u = active[highestActive].back();
+            active[highestActive].pop_back();
+            if (height[u] != highestActive || excess[u] == 0) continue;
+
+            discharge(u);
+            discharges++;
+
+            if (relabelWork > relabelLimit) {
+                globalRelabel();
+                globalRelabels++;
+            }
+        }
+
+        long long flowValue = excess[sink];
+        returnExcessToSource();
+        return flowValue;
+    }
+};
+
+#endif // PUSH_RELABEL_HPP
@@ -2,161 +2,298 @@
 #include <fstream>
 #include <vector>
 #include <queue>
-#include <unordered_map>
-#include "json.hpp"  // Include the nlohmann/json library
+#include <string>
+#include <iomanip>
+#include <sstream>
+#include "flow_graph.hpp"
+#include "cost_scaling.hpp"
+#include "successive_shortest_path.hpp"
+#include "flow_result.hpp"
+#include "network_simplex.hpp"
+#include "multi_commodity_flow.hpp"
+#include "command_line.hpp"
 
-using json = nlohmann::json;
 using namespace std;
 
-// Structure for an edge in the graph
-struct Edge {
-    int from, to, capacity, cost, flow;
+// Min-cost max flow engines, chosen at runtime with --engine=<name>
+enum class MinCostEngine {
+    SuccessiveShortestPath,
+    CostScaling,
+    NetworkSimplex,
 };
 
+bool parseMinCostEngine(const string &name, MinCostEngine &engine) {
+    if (name == "ssp") engine = MinCostEngine::SuccessiveShortestPath;
+    else if (name == "cost-scaling") engine = MinCostEngine::CostScaling;
+    else if (name == "network-simplex") engine = MinCostEngine::NetworkSimplex;
+    else return false;
+    return true;
+}
+
+bool parseDijkstraQueue(const string &name, DijkstraQueue &queue) {
+    for (DijkstraQueue q : {DijkstraQueue::Auto, DijkstraQueue::BinaryHeap, DijkstraQueue::Dial, DijkstraQueue::RadixHeap}) {
+        if (name == dijkstraQueueName(q)) {
+            queue = q;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseSspSearch(const string &name, SspSearch &search) {
+    for (SspSearch s : {SspSearch::Full, SspSearch::EarlyExit, SspSearch::Bidirectional}) {
+        if (name == sspSearchName(s)) {
+            search = s;
+            return true;
+        }
+    }
+    return false;
+}
+
 class MinCostMaxFlow {
 private:
-    unordered_map<string, int> nodeMap;  // Maps node names to integer indices
-    unordered_map<int, vector<int>> adj;
-    vector<Edge> edges;
-    int numNodes = 0;
+    FlowGraph graph;
+    string engineSummary;               // Engine-specific counters of the last solve
+    vector<FlowPath> decomposition;     // Filled by the network simplex engine
 
 public:
-    MinCostMaxFlow() {}
+    DijkstraQueue dijkstraQueue = DijkstraQueue::Auto;  // Queue of the SSP engine
+    SspSearch sspSearch = SspSearch::EarlyExit;         // How far each SSP Dijkstra runs
 
-    void addEdge(int u, int v, int capacity, int cost) {
-        edges.push_back({u, v, capacity, cost, 0});
-        edges.push_back({v, u, 0, -cost, 0});
-        adj[u].push_back(edges.size() - 2);
-        adj[v].push_back(edges.size() - 1);
-    }
+    MinCostMaxFlow() {}
 
-    void loadGraphFromJSON(const string &filename) {
-        ifstream file(filename);
-        if (!file) {
+    bool loadGraphFromJSON(const string &filename, bool quiet = false) {
+        if (!loadFlowGraph(filename, graph)) {
             cerr << "Error: Unable to open " << filename << endl;
-            return;
+            return false;
         }
-
-        json networkData;
-        file >> networkData;
-        file.close();
-
-        int nodeCounter = 0;
-        for (auto it = networkData.begin(); it != networkData.end(); ++it) {
-            string nodeName = it.key();
-            if (nodeMap.find(nodeName) == nodeMap.end()) {
-                nodeMap[nodeName] = nodeCounter++;
+        if (!quiet) {
+            string listing;
+            for (int i = 0; i < graph.numEdges(); i++) {
+                int a = graph.inputArc[i];
+                listing += "Added edge: ";
+                listing += graph.nodeName(graph.tail(a));
+                listing += " -> ";
+                listing += graph.nodeName(graph.head[a]);
+                listing += " | Capacity: " + to_string(graph.capacity[a]) + " | Cost: " + to_string(graph.cost[a]) + "\n";
             }
+            cout << listing;
         }
+        cout << "Total nodes after processing: " << graph.numNodes << endl;
+        return true;
+    }
 
-        for (auto it = networkData.begin(); it != networkData.end(); ++it) {
-            string from = it.key();
-            int u = nodeMap[from];
-            for (auto& edge : it.value()) {
-                string dest = edge["destination"];
-                int capacity = edge["capacity"];
-                int cost = 1;
+    FlowResult minCostMaxFlow(NodeId source, NodeId sink) {
+        FlowResult result;
+        SuccessiveShortestPath solver(graph, result.flow);
+        solver.queue = dijkstraQueue;
+        solver.search = sspSearch;
+        pair<int, int> flowAndCost;
+        timeSolve(result.stats, [&] { flowAndCost = solver.minCostMaxFlow(source, sink); });
+        result.value = flowAndCost.first;
+        result.cost = flowAndCost.second;
+        result.stats.augmentations = solver.augmentations;
+        result.stats.arcScans = solver.arcScans;
+        engineSummary = "Augmenting Paths: " + to_string(solver.augmentations) + " | Dijkstra Queue: " + dijkstraQueueName(solver.usedQueue) +
+                        " | Search: " + sspSearchName(solver.search);
+        return result;
+    }
 
-                if (nodeMap.find(dest) == nodeMap.end()) {
-                    nodeMap[dest] = nodeCounter++;
-                }
-                int v = nodeMap[dest];
-                addEdge(u, v, capacity, cost);
-                cout << "Added edge: " << from << " -> " << dest
-                     << " | Capacity: " << capacity << " | Cost: " << cost << endl;
-            }
-        }
-        numNodes = nodeCounter;
-        cout << "Total nodes after processing: " << numNodes << endl;
+    // Goldberg-Tarjan cost scaling; same result as minCostMaxFlow
+    FlowResult costScalingMinCostMaxFlow(NodeId source, NodeId sink) {
+        FlowResult result;
+        vector<int> residual(graph.capacity.begin(), graph.capacity.end());
+        CostScalingMinCostFlow solver(graph, residual);
+        pair<int, int> flowAndCost;
+        timeSolve(result.stats, [&] { flowAndCost = solver.minCostMaxFlow(source, sink); });
+        result.value = flowAndCost.first;
+        result.cost = flowAndCost.second;
+        result.stats.augmentations = solver.pushes;
+        result.stats.arcScans = solver.arcScans;
+        result.setFlowFromResidual(graph, residual);
+        engineSummary = "Cost Scaling Phases: " + to_string(solver.phases) + " | Pushes: " + to_string(solver.pushes) +
+                        " | Relabels: " + to_string(solver.relabels);
+        return result;
     }
 
-    pair<int, int> minCostMaxFlow(int source, int sink) {
-        int flow = 0, cost = 0;
-        vector<int> potential(numNodes, 0);
-
-        while (true) {
-            const int INF = 1e9;
-            vector<int> dist(numNodes, INF);
-            vector<int> parent(numNodes, -1);
-            vector<int> parentEdge(numNodes, -1);
-            priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
-
-            dist[source] = 0;
-            pq.push(make_pair(0, source));
-
-            while (!pq.empty()) {
-                pair<int, int> top = pq.top();
-                pq.pop();
-                int d = top.first, u = top.second;
-                if (d != dist[u]) continue;
-                for (int idx : adj[u]) {
-                    Edge &e = edges[idx];
-                    if (e.capacity > e.flow) {
-                        int nd = d + e.cost + potential[u] - potential[e.to];
-                        if (nd < dist[e.to]) {
-                            dist[e.to] = nd;
-                            parent[e.to] = u;
-                            parentEdge[e.to] = idx;
-                            pq.push(make_pair(nd, e.to));
-                        }
-                    }
-                }
-            }
+    // Network simplex with block search; the flow decomposition is computed
+    // after the timed solve
+    FlowResult networkSimplexMinCostMaxFlow(NodeId source, NodeId sink) {
+        FlowResult result;
+        vector<int> residual;
+        NetworkSimplex solver(graph, residual);
+        pair<int, int> flowAndCost;
+        timeSolve(result.stats, [&] { flowAndCost = solver.minCostMaxFlow(source, sink); });
+        result.value = flowAndCost.first;
+        result.cost = flowAndCost.second;
+        result.stats.augmentations = solver.pivots;
+        result.stats.arcScans = solver.arcScans;
+        result.setFlowFromResidual(graph, residual);
+        engineSummary = "Network Simplex Pivots: " + to_string(solver.pivots) +
+                        " | Degenerate: " + to_string(solver.degeneratePivots);
+        decomposition = solver.decompose(source, sink);
+        return result;
+    }
 
-            if (dist[sink] == INF) break;
+    FlowResult solve(MinCostEngine engine, NodeId source, NodeId sink) {
+        engineSummary.clear();
+        decomposition.clear();
+        if (engine == MinCostEngine::CostScaling) return costScalingMinCostMaxFlow(source, sink);
+        if (engine == MinCostEngine::NetworkSimplex) return networkSimplexMinCostMaxFlow(source, sink);
+        return minCostMaxFlow(source, sink);
+    }
 
-            for (int i = 0; i < numNodes; i++) {
-                if (dist[i] < INF) potential[i] += dist[i];
+    // Reporting pass over a finished solve, written as one buffer
+    void report(const FlowResult &result, bool quiet) {
+        string text = engineSummary + "\n";
+        text += "Solve Time: " + to_string(result.stats.seconds) + " seconds | Arc scans: " + to_string(result.stats.arcScans) + "\n";
+        if (!quiet && !decomposition.empty()) {
+            text += "Flow Decomposition:\n";
+            for (const FlowPath &path : decomposition) {
+                text += "  " + to_string(path.amount) + " via ";
+                for (size_t i = 0; i < path.nodes.size(); i++) {
+                    if (i) text += " -> ";
+                    text += graph.nodeName(path.nodes[i]);
+                }
+                text += "\n";
             }
+        }
+        cout << text;
+    }
 
-            int pushFlow = INF;
-            for (int v = sink; v != source; v = parent[v]) {
-                int idx = parentEdge[v];
-                pushFlow = min(pushFlow, edges[idx].capacity - edges[idx].flow);
-            }
+    // Medical, express and standard parcels sharing drone capacity. Without
+    // explicit commodities all three go from Source to Sink and split the
+    // single-commodity max flow 20 / 30 / 50.
+    bool multiCommodity(vector<Commodity> commodities, double epsilon, bool quiet) {
+        if (commodities.empty()) {
+            NodeId source = getNodeIndex("Source"), sink = getNodeIndex("Sink");
+            if (source == INVALID_NODE || sink == INVALID_NODE) return false;
+            vector<int> residual(graph.capacity.begin(), graph.capacity.end());
+            double total = (double)Dinic(graph, residual).maxFlow(source, sink);
+            commodities = {{"medical", source, sink, 0.2 * total},
+                           {"express", source, sink, 0.3 * total},
+                           {"standard", source, sink, 0.5 * total}};
+        }
+
+        MultiCommodityFlow solver(graph);
+        solver.epsilon = epsilon;
+        FlowStats stats;
+        timeSolve(stats, [&] { solver.maxConcurrentFlow(commodities); });
 
-            for (int v = sink; v != source; v = parent[v]) {
-                int idx = parentEdge[v];
-                edges[idx].flow += pushFlow;
-                edges[idx ^ 1].flow -= pushFlow;
-                cost += pushFlow * edges[idx].cost;
+        ostringstream text;
+        text << fixed << setprecision(2);
+        text << "Multi-Commodity Flow (Garg-Konemann, epsilon " << epsilon << ")\n";
+        for (size_t j = 0; j < commodities.size(); j++) {
+            const Commodity &c = commodities[j];
+            text << "  " << c.name << ": " << solver.routed[j] << " of " << c.demand << " routed\n";
+            if (quiet) continue;
+            for (int i = 0; i < graph.numEdges(); i++) {
+                int a = graph.inputArc[i];
+                if (solver.flow[j][a] < 0.005) continue;
+                text << "    " << graph.nodeName(graph.tail(a)) << " to " << graph.nodeName(graph.head[a]) << ": " << solver.flow[j][a] << "\n";
             }
-            flow += pushFlow;
-            cout << "Augmented Flow: " << pushFlow
-                 << " | Total Flow: " << flow
-                 << " | Total Cost: " << cost << endl;
         }
-        return make_pair(flow, cost);
+        text << "Concurrent Fraction: " << solver.lambda << "\n";
+        text << "Total Cost (Energy Usage): " << solver.cost << "\n";
+        text << "Phases: " << solver.phases << " | Paths Routed: " << solver.augmentations << "\n";
+        text << "Solve Time: " << setprecision(6) << stats.seconds << " seconds | Arc scans: " << solver.arcScans << "\n";
+        cout << text.str();
+        return true;
     }
 
-    int getNodeIndex(const string &nodeName) {
-        if (nodeMap.find(nodeName) == nodeMap.end()) {
+    NodeId getNodeIndex(const string &nodeName) {
+        NodeId node = graph.nodeId(nodeName);
+        if (node == INVALID_NODE) {
             cerr << "Error: Node " << nodeName << " not found in graph!" << endl;
-            return -1;
         }
-        return nodeMap[nodeName];
+        return node;
     }
 };
 
-int main() {
+int main(int argc, char *argv[]) {
+    string filename = "network.json";
+    MinCostEngine engine = MinCostEngine::SuccessiveShortestPath;
+    DijkstraQueue dijkstraQueue = DijkstraQueue::Auto;
+    SspSearch sspSearch = SspSearch::EarlyExit;
+    bool quiet = false, multi = false;
+    vector<string> commoditySpecs;
+    double epsilon = 0.1;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--quiet" || arg == "-q") {
+            quiet = true;
+        } else if (arg.rfind("--engine=", 0) == 0) {
+            if (!parseMinCostEngine(arg.substr(9), engine)) {
+                cerr << "Error: Unknown engine " << arg.substr(9) << " (expected ssp, cost-scaling or network-simplex)" << endl;
+                return 1;
+            }
+        } else if (arg.rfind("--queue=", 0) == 0) {
+            if (!parseDijkstraQueue(arg.substr(8), dijkstraQueue)) {
+                cerr << "Error: Unknown queue " << arg.substr(8) << " (expected auto, binary-heap, dial or radix-heap)" << endl;
+                return 1;
+            }
+        } else if (arg.rfind("--search=", 0) == 0) {
+            if (!parseSspSearch(arg.substr(9), sspSearch)) {
+                cerr << "Error: Unknown search " << arg.substr(9) << " (expected full, early-exit or bidirectional)" << endl;
+                return 1;
+            }
+        } else if (arg == "--multicommodity") {
+            multi = true;
+        } else if (arg.rfind("--commodity=", 0) == 0) {
+            multi = true;
+            commoditySpecs.push_back(arg.substr(12));
+        } else if (arg.rfind("--epsilon=", 0) == 0) {
+            if (!parseNumber(arg.substr(10), epsilon) || epsilon <= 0 || epsilon >= 1) {
+                cerr << "Error: Invalid epsilon " << arg.substr(10) << " (expected a number between 0 and 1)" << endl;
+                return 1;
+            }
+        } else {
+            filename = arg;
+        }
+    }
+
     MinCostMaxFlow mcmf;
-    mcmf.loadGraphFromJSON("network.json");
+    mcmf.dijkstraQueue = dijkstraQueue;
+    mcmf.sspSearch = sspSearch;
+    if (!mcmf.loadGraphFromJSON(filename, quiet)) return 1;
+
+    if (multi) {
+        // Each commodity is name:source:sink:demand
+        vector<Commodity> commodities;
+        for (const string &spec : commoditySpecs) {
+            vector<string> fields;
+            stringstream parts(spec);
+            for (string field; getline(parts, field, ':');) fields.push_back(field);
+            if (fields.size() != 4) {
+                cerr << "Error: --commodity expects name:source:sink:demand, got " << spec << endl;
+                return 1;
+            }
+            double demand = 0;
+            if (!parseNumber(fields[3], demand) || demand < 0) {
+                cerr << "Error: Invalid demand " << fields[3] << " in --commodity " << spec << endl;
+                return 1;
+            }
+            Commodity c{fields[0], mcmf.getNodeIndex(fields[1]), mcmf.getNodeIndex(fields[2]), demand};
+            if (c.source == INVALID_NODE || c.sink == INVALID_NODE) return 1;
+            commodities.push_back(c);
+        }
+        return mcmf.multiCommodity(commodities, epsilon, quiet) ? 0 : 1;
+    }
 
-    int source = mcmf.getNodeIndex("Source");
-    int sink = mcmf.getNodeIndex("Sink");
+    NodeId source = mcmf.getNodeIndex("Source");
+    NodeId sink = mcmf.getNodeIndex("Sink");
 
-    if (source == -1 || sink == -1) {
+    if (source == INVALID_NODE || sink == INVALID_NODE) {
         cerr << "Error: Source or Sink node not found!" << endl;
         return 1;
     }
     cout << "Source index: " << source << ", Sink index: " << sink << endl;
 
-    pair<int, int> result = mcmf.minCostMaxFlow(source, sink);
-    int maxFlow = result.first;
-    int minCost = result.second;
+    FlowResult result = mcmf.solve(engine, source, sink);
+    mcmf.report(result, quiet);
 
-    cout << "Final Maximum Flow: " << maxFlow << endl;
-    cout << "Final Minimum Cost (Energy Usage): " << minCost << endl;
+    cout << "Final Maximum Flow: " << result.value << endl;
+    cout << "Final Minimum Cost (Energy Usage): " << result.cost << endl;
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,228 @@
+#ifndef SUCCESSIVE_SHORTEST_PATH_HPP
+#define SUCCESSIVE_SHORTEST_PATH_HPP
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "dijkstra_queues.hpp"
+#include "flow_graph.hpp"
+
+// How far each SSP Dijkstra runs. Full settles every reachable node.
+// EarlyExit stops once nothing closer than the sink is left. Bidirectional
+// alternates with a search from the sink over reversed residual arcs and
+// stops when the two radii add up to the best path found.
+enum class SspSearch { Full, EarlyExit, Bidirectional };
+
+inline const char *sspSearchName(SspSearch search) {
+    switch (search) {
+    case SspSearch::Full: return "full";
+    case SspSearch::Bidirectional: return "bidirectional";
+    default: return "early-exit";
+    }
+}
+
+// Successive shortest path min-cost max flow on a FlowGraph.
+//
+// Each iteration runs Dijkstra on reduced costs cost + potential[u] -
+// potential[v], which stay non-negative because the potentials are raised
+// by the last distances, and pushes the bottleneck along the cheapest path.
+// Works on a caller-owned flow array indexed by arc.
+//
+// Negative edge costs are allowed as long as no negative cycle is reachable:
+// the potentials then start from Bellman-Ford distances instead of zero.
+// A reduced cost that still comes out negative is never pushed; the solve
+// stops and reports it.
+//
+// Reduced costs are small non-negative integers, so the Dijkstra queue is
+// pluggable (dijkstra_queues.hpp). By default it is picked from the largest
+// arc cost: Dial's buckets for small costs, a radix heap otherwise. The
+// distances, parents and queues live in DijkstraWorkspaces kept across
+// iterations and solves, and only the nodes a search reached are reset
+// (and have their potential changed) afterwards.
+//
+// A search that stops early leaves most distances unknown. With mu the
+// path length and rf, rb the forward and backward radii clipped so that
+// rf + rb = mu, every node v gets potential[v] += max(0, rb - distB[v]) -
+// max(0, rf - distF[v]). That is the usual min(dist, mu) correction shifted
+// by a constant, so unreached nodes keep their potential, reduced costs
+// stay non-negative and the path found has reduced cost zero.
+class SuccessiveShortestPath {
+private:
+    const FlowGraph &graph;
+    std::vector<int> &flow;
+    std::vector<int> potential;
+    // Labels of the last search: forward from the source, backward from the
+    // sink. Backward parent arcs point towards the sink.
+    DijkstraWorkspace forward, backward;
+    int pathLength = 0;                 // Shortest source-sink reduced length found
+    NodeId meet = INVALID_NODE;         // Node where the two halves of that path join
+    bool negativeReducedCost = false;   // Set if the potentials ever stop being feasible
+    std::vector<char> fromSource;       // Seeded solves only: reachable from the source at the start
+
+    // Bellman-Ford (queue-based) from the source over arcs with capacity, so
+    // that negative edge costs start out with non-negative reduced costs.
+    // Nodes it cannot reach never become reachable, so the searches skip
+    // them. False if a negative-cost cycle is reachable.
+    bool seedPotentials(NodeId source) {
+        const int INF = DijkstraWorkspace::INF;
+        std::vector<long long> dist(graph.numNodes, INF);
+        std::vector<int> passes(graph.numNodes, 0); // Times queued: at most once per pass
+        std::vector<char> queued(graph.numNodes, false);
+        std::vector<NodeId> queue(1, source);
+        dist[source] = 0;
+        queued[source] = true;
+        for (size_t i = 0; i < queue.size(); i++) {
+            NodeId u = queue[i];
+            queued[u] = false;
+            arcScans += graph.offset[u + 1] - graph.offset[u];
+            for (int a = graph.offset[u]; a < graph.offset[u + 1]; a++) {
+                NodeId v = graph.head[a];
+                if (graph.capacity[a] <= 0 || dist[u] + graph.cost[a] >= dist[v]) continue;
+                dist[v] = dist[u] + graph.cost[a];
+                if (!queued[v]) {
+                    if (++passes[v] > (int)graph.numNodes) return false;
+                    queued[v] = true;
+                    queue.push_back(v);
+                }
+            }
+        }
+        fromSource.assign(graph.numNodes, false);
+        for (NodeId v = 0; v < graph.numNodes; v++) {
+            fromSource[v] = dist[v] != INF;
+            potential[v] = fromSource[v] ? (int)dist[v] : 0;
+        }
+        return true;
+    }
+
+    // Settles u at distance d. Forward relaxes the residual arcs leaving u,
+    // backward the residual arcs entering it. Any node labelled from both
+    // sides closes a candidate path.
+    template <typename Queue>
+    void scan(bool isForward, NodeId u, int d, Queue &pq) {
+        DijkstraWorkspace &side = isForward ? forward : backward;
+        const DijkstraWorkspace &other = isForward ? backward : forward;
+        arcScans += graph.offset[u + 1] - graph.offset[u];
+        for (int a = graph.offset[u]; a < graph.offset[u + 1]; a++) {
+            NodeId v = graph.head[a];
+            int arc = isForward ? a : graph.reverse[a];
+            if (graph.capacity[arc] <= flow[arc] || (!fromSource.empty() && !fromSource[v])) continue;
+            int reduced = graph.cost[arc] + (isForward ? potential[u] - potential[v] : potential[v] - potential[u]);
+            if (reduced < 0) {
+                // The monotone queues take unsigned keys, so this must never be pushed
+                negativeReducedCost = true;
+                continue;
+            }
+            int nd = d + reduced;
+            if (!side.relax(v, nd, arc)) continue;
+            pq.push((uint32_t)nd, v);
+            if (other.dist[v] != DijkstraWorkspace::INF && nd + other.dist[v] < pathLength) {
+                pathLength = nd + other.dist[v];
+                meet = v;
+            }
+        }
+    }
+
+    // One Dijkstra plus the potential update; false when the sink is cut off
+    template <typename Queue>
+    bool shortestPath(NodeId source, NodeId sink, Queue &forwardQueue, Queue &backwardQueue) {
+        const int INF = DijkstraWorkspace::INF;
+        forward.reset();
+        backward.reset();
+        forwardQueue.clear();
+        backwardQueue.clear();
+        forward.relax(source, 0, -1);
+        forwardQueue.push(0, source);
+        backward.relax(sink, 0, -1);
+        if (search == SspSearch::Bidirectional) backwardQueue.push(0, sink);
+        pathLength = INF;
+        meet = INVALID_NODE;
+
+        int radius[2] = {0, 0}; // Last distance settled forward, backward
+        bool isForward = true;
+        while (true) {
+            Queue &pq = isForward ? forwardQueue : backwardQueue;
+            if (pq.empty()) {
+                radius[!isForward] = INF; // Everything that side reaches is settled
+                break;
+            }
+            std::pair<uint32_t, NodeId> top = pq.pop();
+            int d = (int)top.first;
+            NodeId u = top.second;
+            if (d != (isForward ? forward : backward).dist[u]) continue;
+            radius[!isForward] = d;
+            if (search != SspSearch::Full && d + radius[isForward] >= pathLength) break;
+            scan(isForward, u, d, pq);
+            if (search == SspSearch::Bidirectional) isForward = !isForward;
+        }
+        if (pathLength == INF) return false;
+
+        int forwardReach = std::min(radius[0], pathLength), backwardReach = pathLength - forwardReach;
+        for (NodeId v : forward.touched) potential[v] -= std::max(0, forwardReach - forward.dist[v]);
+        for (NodeId v : backward.touched) potential[v] += std::max(0, backwardReach - backward.dist[v]);
+        return true;
+    }
+
+    // Calls visit(arc) for every arc of the last path
+    template <typename Visit>
+    void forEachPathArc(NodeId source, NodeId sink, Visit visit) const {
+        for (NodeId v = meet; v != source; v = graph.tail(forward.parentArc[v])) visit(forward.parentArc[v]);
+        for (NodeId v = meet; v != sink; v = graph.head[backward.parentArc[v]]) visit(backward.parentArc[v]);
+    }
+
+    template <typename Queue>
+    std::pair<int, int> solve(NodeId source, NodeId sink, Queue DijkstraWorkspace::*queueOf) {
+        int totalFlow = 0, cost = 0;
+        potential.assign(graph.numNodes, 0);
+        flow.assign(graph.numArcs(), 0);
+        forward.prepare(graph.numNodes);
+        backward.prepare(graph.numNodes);
+        negativeReducedCost = false;
+        fromSource.clear();
+        bool negativeCosts = std::any_of(graph.inputArc.begin(), graph.inputArc.end(),
+                                         [&](int a) { return graph.capacity[a] > 0 && graph.cost[a] < 0; });
+        if (negativeCosts && !seedPotentials(source)) {
+            std::cerr << "Error: the network has a negative-cost cycle, which successive shortest paths cannot solve" << std::endl;
+            return std::make_pair(0, 0);
+        }
+
+        while (shortestPath(source, sink, forward.*queueOf, backward.*queueOf)) {
+            if (negativeReducedCost) break;
+            int pushFlow = DijkstraWorkspace::INF;
+            forEachPathArc(source, sink, [&](int a) { pushFlow = std::min(pushFlow, graph.capacity[a] - flow[a]); });
+            forEachPathArc(source, sink, [&](int a) {
+                flow[a] += pushFlow;
+                flow[graph.reverse[a]] -= pushFlow;
+                cost += pushFlow * graph.cost[a];
+            });
+            totalFlow += pushFlow;
+            augmentations++;
+        }
+        if (negativeReducedCost) {
+            std::cerr << "Error: a negative reduced cost appeared, so the SSP result is not optimal" << std::endl;
+        }
+        return std::make_pair(totalFlow, cost);
+    }
+
+public:
+    DijkstraQueue queue = DijkstraQueue::Auto;
+    DijkstraQueue usedQueue = DijkstraQueue::Auto;  // What the last solve ran with
+    SspSearch search = SspSearch::EarlyExit;
+
+    // Work done by the last solve
+    long long augmentations = 0, arcScans = 0;
+
+    SuccessiveShortestPath(const FlowGraph &g, std::vector<int> &arcFlow) : graph(g), flow(arcFlow) {}
+
+    // Returns (flow, cost) from a zero flow
+    std::pair<int, int> minCostMaxFlow(NodeId source, NodeId sink) {
+        augmentations = arcScans = 0;
+        usedQueue = queue == DijkstraQueue::Auto ? chooseDijkstraQueue(graph) : queue;
+        if (source == sink) return std::make_pair(0, 0);
+        if (usedQueue == DijkstraQueue::Dial) return solve(source, sink, &DijkstraWorkspace::dial);
+        if (usedQueue == DijkstraQueue::RadixHeap) return solve(source, sink, &DijkstraWorkspace::radixHeap);
+        return solve(source, sink, &DijkstraWorkspace::binaryHeap);
+    }
+};
+
+#endif // SUCCESSIVE_SHORTEST_PATH_HPP
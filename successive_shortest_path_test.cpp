@@ -0,0 +1,71 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "flow_graph.hpp"
+#include "network_simplex.hpp"
+#include "successive_shortest_path.hpp"
+
+using namespace std;
+
+// SSP against network simplex for every Dijkstra queue and search mode.
+// Besides random networks with non-negative costs, the cases include
+// negative edge costs without negative cycles (random DAGs), which SSP
+// solves from Bellman-Ford potentials and the automatic queue choice sends
+// to the binary heap.
+
+const DijkstraQueue QUEUES[] = {DijkstraQueue::Auto, DijkstraQueue::BinaryHeap, DijkstraQueue::Dial, DijkstraQueue::RadixHeap};
+const SspSearch SEARCHES[] = {SspSearch::Full, SspSearch::EarlyExit, SspSearch::Bidirectional};
+
+bool runCase(const string &name, int n, const vector<vector<int>> &edges, NodeId s, NodeId t) {
+    FlowGraphBuilder builder;
+    for (int u = 0; u < n; u++) builder.addNode("n" + to_string(u));
+    for (const auto &e : edges) builder.addEdge(e[0], e[1], e[2], e[3]);
+    FlowGraph graph = builder.build();
+
+    vector<int> reference;
+    pair<int, int> expected = NetworkSimplex(graph, reference).minCostMaxFlow(s, t);
+    for (DijkstraQueue queue : QUEUES) {
+        for (SspSearch search : SEARCHES) {
+            vector<int> flow;
+            SuccessiveShortestPath solver(graph, flow);
+            solver.queue = queue;
+            solver.search = search;
+            pair<int, int> result = solver.minCostMaxFlow(s, t);
+            if (result != expected) {
+                cout << name << " failed with " << dijkstraQueueName(queue) << " / " << sspSearchName(search) << ": flow "
+                     << result.first << " cost " << result.second << ", expected " << expected.first << " / "
+                     << expected.second << "\n";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main() {
+    int failures = 0;
+
+    // Source -> A -> B -> Sink with a negative middle edge: flow 10, cost 5
+    failures += !runCase("negative middle edge", 4, {{0, 2, 10, 1}, {2, 3, 10, -4}, {3, 1, 10, 8}}, 0, 1);
+
+    mt19937 rng(2024);
+    for (int trial = 0; trial < 1500; trial++) {
+        bool negative = trial % 2 == 1;
+        int n = 2 + rng() % 9;
+        int m = 1 + rng() % 20;
+        vector<vector<int>> edges;
+        for (int i = 0; i < m; i++) {
+            int u = rng() % n, v = rng() % n;
+            // Negative costs only along increasing ids, so no cycle is negative
+            if (negative && u > v) swap(u, v);
+            int cost = negative ? (int)(rng() % 21) - 10 : (int)(rng() % 100);
+            if (u != v) edges.push_back({u, v, (int)(rng() % 10), cost});
+        }
+        NodeId s = negative ? 0 : rng() % n, t = negative ? n - 1 : rng() % n;
+        failures += !runCase("random trial " + to_string(trial), n, edges, s, t);
+    }
+
+    cout << (failures == 0 ? "All successive shortest path checks passed" : to_string(failures) + " checks failed") << endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <limits>
+#include "flow_graph.hpp"
+#include "augmenting_paths.hpp"
+#include "network_simplex.hpp"
+#include "flow_result.hpp"
+#include "time_expanded_network.hpp"
+#include "command_line.hpp"
+
+using namespace std;
+
+// Base network and its expansion over the day
+FlowGraph baseGraph;
+TimeExpandedNetwork expanded;
+
+// Max flow over the whole horizon with Dinic
+FlowResult maxFlowOverTime() {
+    const FlowGraph &graph = expanded.graph;
+    FlowResult result;
+    vector<int> residual(graph.capacity.begin(), graph.capacity.end());
+    Dinic solver(graph, residual);
+    timeSolve(result.stats, [&] { result.value = solver.maxFlow(expanded.source, expanded.sink); });
+    result.stats.augmentations = solver.augmentations;
+    result.stats.arcScans = solver.arcScans;
+    result.setFlowFromResidual(graph, residual);
+    return result;
+}
+
+// Same deliveries at the lowest total energy, with network simplex
+FlowResult minCostFlowOverTime() {
+    const FlowGraph &graph = expanded.graph;
+    FlowResult result;
+    vector<int> residual;
+    NetworkSimplex solver(graph, residual);
+    pair<int, int> flowAndCost;
+    timeSolve(result.stats, [&] { flowAndCost = solver.minCostMaxFlow(expanded.source, expanded.sink); });
+    result.value = flowAndCost.first;
+    result.cost = flowAndCost.second;
+    result.stats.augmentations = solver.pivots;
+    result.stats.arcScans = solver.arcScans;
+    result.setFlowFromResidual(graph, residual);
+    return result;
+}
+
+// Packages reaching the Sink in each slot, as one buffer
+void reportDeliveries(const FlowResult &result) {
+    const FlowGraph &graph = expanded.graph;
+    vector<long long> delivered(expanded.slots(), 0);
+    for (int a = graph.offset[expanded.sink]; a < graph.offset[expanded.sink + 1]; a++) {
+        int slot = expanded.slot(graph.head[a]);
+        if (slot >= 0) delivered[slot] += result.flow[graph.reverse[a]];
+    }
+    string text = "Deliveries per Slot:\n";
+    for (int t = 0; t < expanded.slots(); t++) text += "  Slot " + to_string(t) + ": " + to_string(delivered[t]) + "\n";
+    cout << text;
+}
+
+int main(int argc, char *argv[]) {
+    string filename = "network.json";
+    TimeExpansionOptions options;
+    bool quiet = false, minCost = false;
+    // Integer options as {prefix, target, smallest allowed value}
+    struct IntOption {
+        const char *prefix;
+        int *target;
+        int low;
+    } intOptions[] = {
+        {"--slots=", &options.slots, 1},
+        {"--travel-slots=", &options.travelSlots, 0},
+        {"--queue-holdover=", &options.queueHoldoverCapacity, 0},
+        {"--drone-holdover=", &options.droneHoldoverCapacity, 0},
+    };
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool matched = false;
+        for (const IntOption &option : intOptions) {
+            string prefix = option.prefix;
+            if (arg.rfind(prefix, 0) != 0) continue;
+            long long value = 0;
+            if (!parseInteger(arg.substr(prefix.size()), value, option.low, numeric_limits<int>::max())) {
+                cerr << "Error: Invalid value for " << prefix.substr(0, prefix.size() - 1) << ": " << arg.substr(prefix.size())
+                     << " (expected an integer of at least " << option.low << ")" << endl;
+                return 1;
+            }
+            *option.target = (int)value;
+            matched = true;
+        }
+        if (matched) continue;
+        if (arg == "--quiet" || arg == "-q") quiet = true;
+        else if (arg == "--min-cost") minCost = true;
+        else filename = arg;
+    }
+
+    if (!loadFlowGraph(filename, baseGraph)) {
+        cerr << "Error: Could not open file " << filename << endl;
+        return 1;
+    }
+    FlowStats buildStats;
+    bool built = false;
+    timeSolve(buildStats, [&] { built = expanded.build(baseGraph, options); });
+    if (!built) return 1;
+
+    cout << fixed << setprecision(6);
+    cout << "Time-expanded network: " << options.slots << " slots, " << expanded.graph.numNodes << " nodes, "
+         << expanded.graph.numEdges() << " edges, built in " << buildStats.seconds << " seconds\n";
+
+    FlowResult flow = maxFlowOverTime();
+    cout << "Max Flow over " << options.slots << " slots (Dinic): " << flow.value << " | Solve Time: " << flow.stats.seconds << " seconds\n";
+    if (!quiet) reportDeliveries(flow);
+
+    if (minCost) {
+        FlowResult cheapest = minCostFlowOverTime();
+        cout << "Minimum Cost (Energy Usage): " << cheapest.cost << " | Network Simplex Pivots: " << cheapest.stats.augmentations
+             << " | Solve Time: " << cheapest.stats.seconds << " seconds\n";
+        if (!quiet) reportDeliveries(cheapest);
+    }
+    cout << flush;
+    return 0;
+}
@@ -0,0 +1,190 @@
+#ifndef TIME_EXPANDED_NETWORK_HPP
+#define TIME_EXPANDED_NETWORK_HPP
+
+#include <iostream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "flow_graph.hpp"
+
+struct TimeExpansionOptions {
+    int slots = 96;                 // A day in 15-minute slots
+    int travelSlots = 1;            // Slots an edge between two layers takes
+    // Per-slot capacity and cost of waiting in place: queueing at warehouses
+    // and destinations, an idle (charging) drone for Drone_ nodes. 0 disables.
+    int queueHoldoverCapacity = std::numeric_limits<int>::max() / 4;
+    int queueHoldoverCost = 0;
+    int droneHoldoverCapacity = std::numeric_limits<int>::max() / 4;
+    int droneHoldoverCost = 0;
+};
+
+// Time-expanded copy of a drone network for scheduled sorties.
+//
+// Every node except Source and Sink is replicated once per slot. A base edge
+// u -> v becomes (u, t) -> (v, t + travelSlots) for every slot that still
+// lands inside the horizon, with the base capacity per slot. Holdover arcs
+// (u, t) -> (u, t + 1) let packages queue and drones wait. Source feeds, and
+// Sink collects from, the copy of every slot.
+//
+// The arrays are filled in two passes over the same edge enumeration, one to
+// count the arcs of every node and one to place them, so no edge list is
+// ever held. Copies get no names of their own: the FlowGraph only names
+// Source and Sink, and name() spells "Drone_3@17" on demand. The base graph
+// must outlive this object.
+class TimeExpandedNetwork {
+private:
+    const FlowGraph *base = nullptr;
+    std::vector<NodeId> replicated;         // Base node of each replica index
+    std::vector<NodeId> replicaIndex;       // Replica index of each base node, INVALID_NODE for the terminals
+    std::vector<char> isDrone;              // Per replica index
+    NodeId baseSource = INVALID_NODE, baseSink = INVALID_NODE;
+    TimeExpansionOptions options;
+
+    // Calls edge(from, to, capacity, cost) for every arc of the expansion,
+    // always in the same order
+    template <typename EdgeFn>
+    void forEachEdge(EdgeFn edge) const {
+        NodeId r = (NodeId)replicated.size();
+        int T = options.slots;
+        for (int t = 0; t < T; t++) {
+            for (int i = 0; i < base->numEdges(); i++) {
+                int a = base->inputArc[i];
+                NodeId u = base->tail(a), v = base->head[a];
+                int capacity = base->capacity[a], cost = base->cost[a];
+                if (u == baseSink || v == baseSource) continue;
+                if (u == baseSource && v == baseSink) edge(source, sink, capacity, cost);
+                else if (u == baseSource) edge(source, node(v, t), capacity, cost);
+                else if (v == baseSink) edge(node(u, t), sink, capacity, cost);
+                else if (t + options.travelSlots < T) edge(node(u, t), node(v, t + options.travelSlots), capacity, cost);
+            }
+            if (t + 1 == T) break;
+            for (NodeId i = 0; i < r; i++) {
+                int capacity = isDrone[i] ? options.droneHoldoverCapacity : options.queueHoldoverCapacity;
+                int cost = isDrone[i] ? options.droneHoldoverCost : options.queueHoldoverCost;
+                if (capacity > 0) edge(2 + t * r + i, 2 + (t + 1) * r + i, capacity, cost);
+            }
+        }
+    }
+
+public:
+    static constexpr NodeId source = 0, sink = 1;
+    FlowGraph graph;
+
+    int slots() const { return options.slots; }
+
+    // Copy of a base node in a slot
+    NodeId node(NodeId baseNode, int slot) const { return 2 + slot * (NodeId)replicated.size() + replicaIndex[baseNode]; }
+
+    NodeId baseNode(NodeId x) const {
+        if (x == source) return baseSource;
+        if (x == sink) return baseSink;
+        return replicated[(x - 2) % replicated.size()];
+    }
+
+    // Slot of a copy, -1 for the terminals
+    int slot(NodeId x) const { return x < 2 ? -1 : (int)((x - 2) / replicated.size()); }
+
+    void name(NodeId x, std::string &out) const {
+        out = base->nodeName(baseNode(x));
+        if (x >= 2) out.append("@").append(std::to_string(slot(x)));
+    }
+
+    std::string name(NodeId x) const {
+        std::string out;
+        name(x, out);
+        return out;
+    }
+
+    bool build(const FlowGraph &baseGraph, const TimeExpansionOptions &expansion) {
+        base = &baseGraph;
+        options = expansion;
+        baseSource = base->nodeId("Source");
+        baseSink = base->nodeId("Sink");
+        if (baseSource == INVALID_NODE || baseSink == INVALID_NODE) {
+            std::cerr << "Error: time expansion needs Source and Sink nodes" << std::endl;
+            return false;
+        }
+        if (options.slots < 1 || options.travelSlots < 0) {
+            std::cerr << "Error: time expansion needs at least one slot" << std::endl;
+            return false;
+        }
+
+        replicated.clear();
+        isDrone.clear();
+        replicaIndex.assign(base->numNodes, INVALID_NODE);
+        for (NodeId u = 0; u < base->numNodes; u++) {
+            if (u == baseSource || u == baseSink) continue;
+            replicaIndex[u] = (NodeId)replicated.size();
+            replicated.push_back(u);
+            isDrone.push_back(base->nodeName(u).substr(0, 6) == "Drone_");
+        }
+
+        uint64_t nodes = 2 + (uint64_t)replicated.size() * options.slots;
+        if (nodes >= INVALID_NODE) {
+            std::cerr << "Error: time expansion has too many nodes" << std::endl;
+            return false;
+        }
+        NodeId n = (NodeId)nodes;
+
+        // Pass one: arcs per node
+        std::vector<int> offset(n + 1, 0);
+        uint64_t m = 0;
+        forEachEdge([&](NodeId from, NodeId to, int, int) {
+            offset[from + 1]++;
+            offset[to + 1]++;
+            m++;
+        });
+        if (2 * m > (uint64_t)std::numeric_limits<int>::max()) {
+            std::cerr << "Error: time expansion has too many arcs" << std::endl;
+            return false;
+        }
+        for (NodeId u = 0; u < n; u++) offset[u + 1] += offset[u];
+
+        // Pass two: place both arcs of every edge, as FlowGraphBuilder does
+        std::vector<int> capacity(2 * m), cost(2 * m), reverse(2 * m), inputArc(m);
+        std::vector<NodeId> head(2 * m);
+        std::vector<int> next(offset.begin(), offset.end() - 1);
+        int i = 0;
+        forEachEdge([&](NodeId from, NodeId to, int edgeCapacity, int edgeCost) {
+            int a = next[from]++;
+            int b = next[to]++;
+            head[a] = to;
+            capacity[a] = edgeCapacity;
+            cost[a] = edgeCost;
+            reverse[a] = b;
+            head[b] = from;
+            capacity[b] = 0;
+            cost[b] = -edgeCost;
+            reverse[b] = a;
+            inputArc[i++] = a;
+        });
+        std::vector<int>().swap(next);
+
+        // Only the terminals are named; "" < "Sink" < "Source" keeps nameOrder sorted
+        std::vector<uint32_t> nameOffset(n + 1, 10);
+        nameOffset[0] = 0;
+        nameOffset[1] = 6;
+        std::string_view names = "SourceSink";
+        std::vector<NodeId> nameOrder;
+        nameOrder.reserve(n);
+        for (NodeId u = 2; u < n; u++) nameOrder.push_back(u);
+        nameOrder.push_back(sink);
+        nameOrder.push_back(source);
+
+        graph = FlowGraph();
+        graph.numNodes = n;
+        graph.offset = std::move(offset);
+        graph.head = std::move(head);
+        graph.capacity = std::move(capacity);
+        graph.cost = std::move(cost);
+        graph.reverse = std::move(reverse);
+        graph.inputArc = std::move(inputArc);
+        graph.nameOffset = std::move(nameOffset);
+        graph.nameData = std::vector<char>(names.begin(), names.end());
+        graph.nameOrder = std::move(nameOrder);
+        return true;
+    }
+};
+
+#endif // TIME_EXPANDED_NETWORK_HPP